@@ -51,17 +51,22 @@
  *    DAC7568使用12位数据(D11-D0)，需左移4位填充到SPI帧
  *    DAC8168使用14位数据(D13-D0)，需左移2位
  *    DAC8568使用全部16位数据(D15-D0)
+ *    由 DAC8568_DEVICE 在编译期选择型号，驱动API的数据参数均为原生分辨率的码值，
+ *    限幅与移位在帧编码中以常量完成，没有运行时分支。
  *
  * 2. 建立时间影响：
- *    输出稳定需等待至少10μs，高速连续写入时需添加延时：
- *    HAL_Delay(1); // 保守延时1ms (实际最低10μs)
+ *    输出稳定需等待至少10μs。驱动用DWT周期计数器按通道限制两次更新的最小间隔，
+ *    只等待实际需要的时间，不使用毫秒级的HAL_Delay：
+ *    DAC8568_SetMinInterval(&hdac1, CHANNEL_A, 10); // 通道A两次更新至少间隔10μs
  */
 /*
  * SPI 外设配置说明 (针对 DAC8568)
  * ----------------------------------------------------------------
  * 参数要求（参考数据手册第7-8页时序图和第6页电气特性）：
  * 1. 模式: 全双工主模式 (DAC8568 为从设备)
- * 2. 数据大小: 8位 (需手动组合为24/32位帧)
+ * 2. 数据大小: 8位或16位 (驱动在初始化时读取 hspi->Init.DataSize 自动选择帧格式，
+ *    16位模式下每个32位帧只需两次DR写入/两次DMA搬运。SCLK为18MHz时每帧耗时由32个SCLK决定，
+ *    主机模型中阻塞发送每帧为610 (16位) 与618 (8位) 个周期，DMA发送相同，节省的主要是DR写入与DMA搬运次数)
  * 3. 时钟极性 (CPOL): 低电平空闲 (CPOL=0)
  * 4. 时钟相位 (CPHA): 数据在第一个边沿采样 (CPHA=0)
  * 5. 传输顺序: MSB 高位在前 (强制要求)
@@ -71,7 +76,7 @@
  * CubeMX 具体设置步骤：
  * 1. Connectivity → SPIx → Mode = "Full-Duplex Master"
  * 2. Parameter Settings →
- *    - Data Size = 8 Bits
+ *    - Data Size = 16 Bits (8 Bits亦可)
  *    - First Bit = MSB First
  *    - Clock Polarity = High  注意这个
  *    - Clock Phase = 1 Edge
@@ -102,6 +107,30 @@ extern "C"
 
 #include "main.h"
 
+// 传输模式配置
+// 1: 若SPI句柄已关联发送DMA (hspi->hdmatx，SPI1对应DMA1通道3)，所有命令帧均以DMA方式发送，
+//    函数启动传输后立即返回，SYNC在传输完成回调中拉高；未关联DMA时自动退回阻塞发送。
+//    SPI为16位数据帧时，DMA通道的外设/内存数据宽度须配置为半字 (Half Word)。
+// 0: 始终使用阻塞方式 HAL_SPI_Transmit 发送。
+#ifndef DAC8568_USE_DMA
+#define DAC8568_USE_DMA 1
+#endif
+
+// 器件型号 (决定数据位宽): 值为分辨率位数
+#define DAC8568_DEVICE_DAC7568 12
+#define DAC8568_DEVICE_DAC8168 14
+#define DAC8568_DEVICE_DAC8568 16
+#ifndef DAC8568_DEVICE
+#define DAC8568_DEVICE DAC8568_DEVICE_DAC8568
+#endif
+#if DAC8568_DEVICE != DAC8568_DEVICE_DAC7568 && DAC8568_DEVICE != DAC8568_DEVICE_DAC8168 && DAC8568_DEVICE != DAC8568_DEVICE_DAC8568
+#error "DAC8568_DEVICE must be DAC8568_DEVICE_DAC7568, DAC8568_DEVICE_DAC8168 or DAC8568_DEVICE_DAC8568"
+#endif
+
+#define DAC8568_RESOLUTION DAC8568_DEVICE                   // 分辨率 (位)
+#define DAC8568_DATA_SHIFT (16 - DAC8568_RESOLUTION)        // 码值在16位数据位中的左移位数
+#define DAC8568_MAX_CODE ((1U << DAC8568_RESOLUTION) - 1U) // 满量程码值
+
 // DAC8568数据帧结构 (31-0位)
 // 31-28位: 前缀位 (PREFIX BITS) - 始终为0
 // 27-24位: 命令位 (CONTROL BITS)
@@ -150,24 +179,347 @@ extern "C"
 #define CLEAR_CODE_FULL_SCALE 0b10   // 清除为全刻度
 #define CLEAR_CODE_NO_OPERATION 0b11 // 无操作
 
+// 阻塞 (轮询) 发送后端选择
+// DAC8568_BACKEND_HAL: 使用 HAL_SPI_Transmit 与 HAL_GPIO_WritePin (默认，可移植性最好)
+// DAC8568_BACKEND_REG: 直接写 SPIx->DR、轮询 TXE/BSY，并通过 GPIOx->BSRR 翻转SYNC。
+//                      省去HAL的句柄加锁、状态检查、超时计时和逐字节标志轮询开销，
+//                      目标是接近32个SCLK的理论下限 (SPI1 18MHz时为128个CPU周期)。
+//                      主机模型 (make -C Host bench) 中SPI1 16位阻塞发送的每帧周期数:
+//                      Write 610 -> 424，SendFrames(64) 467 -> 264 (HAL -> REG)；目标板上以
+//                      两种后端分别编译运行 DAC8568_Bench 得到实测值。
+//                      仅替换阻塞路径，DMA路径不受影响；需要全部走寄存器路径时将 DAC8568_USE_DMA 置0。
+#define DAC8568_BACKEND_HAL 0
+#define DAC8568_BACKEND_REG 1
+#ifndef DAC8568_BACKEND
+#define DAC8568_BACKEND DAC8568_BACKEND_HAL
+#endif
+
+// 影子寄存器: 驱动在句柄中保存每个通道的输入/DAC寄存器、电源模式、LDAC、清除代码与参考状态。
+// 1: 不会改变芯片状态的命令帧直接跳过 (如重复写入相同的设定值)，8通道连发只发送有变化的通道。
+// 0: 仍然维护影子寄存器供查询，但所有命令照常发送。运行中可通过句柄的 skip_redundant 字段切换。
+#ifndef DAC8568_SKIP_REDUNDANT
+#define DAC8568_SKIP_REDUNDANT 1
+#endif
+
+// 上电/软件复位后的DAC码 (16位数据位，与型号无关): DAC8568A/C为零刻度，B/D为中间刻度 (参考数据手册第39页)
+#ifndef DAC8568_RESET_CODE
+#define DAC8568_RESET_CODE 0x0000
+#endif
+
+// 阻塞发送的超时时间 (ms)。32位帧在SCLK为1MHz时也只需32μs，超时说明SPI外设异常，
+// 函数返回 HAL_TIMEOUT 而不是无限等待。
+#ifndef DAC8568_SPI_TIMEOUT
+#define DAC8568_SPI_TIMEOUT 10
+#endif
+
+// 电压换算: 满量程电压 = 参考电压 × 输出增益。
+// 内部参考为2.5V；外部参考电压在此设定 (μV)，运行中可用 DAC8568_SetExternalRef 修改。
+#ifndef DAC8568_EXTERNAL_REF_UV
+#define DAC8568_EXTERNAL_REF_UV 2500000
+#endif
+#define DAC8568_INTERNAL_REF_UV 2500000
+// 输出缓冲增益: 本板使用的等级为2倍 (见 DAC8568_EnableStaticInternalRef 的说明与数据手册31页8.2.1)
+#ifndef DAC8568_OUTPUT_GAIN
+#define DAC8568_OUTPUT_GAIN 2
+#endif
+
+// 时序控制 (DWT->CYCCNT，分辨率为1个HCLK周期，72MHz时约14ns)
+// 软件复位后的恢复时间 (μs): 复位帧发出后函数立即返回，下一帧发送前才等待剩余的时间。
+#ifndef DAC8568_RESET_RECOVERY_US
+#define DAC8568_RESET_RECOVERY_US 50
+#endif
+// 每个通道两次输出更新之间的默认最小间隔 (μs)，0为不限制。
+// 设为10 (最大建立时间) 可保证每次更新的输出都已完全建立；运行中用 DAC8568_SetMinInterval 按通道修改。
+#ifndef DAC8568_MIN_INTERVAL_US
+#define DAC8568_MIN_INTERVAL_US 0
+#endif
+
+// 命令队列长度 (帧数，必须为2的幂)。每个设备一个单生产者/单消费者无锁环形队列:
+// 关联DMA时 DAC8568_Enqueue 在应用代码或中断中O(1)入队，不等待总线与复位恢复 (恢复期内返回0)，
+// 只在启动第一帧时短暂关中断；DMA传输完成回调依次取出并背靠背发送，帧与帧之间不经过主循环。
+// 未关联DMA时入队即在调用者上下文中阻塞发送。
+#ifndef DAC8568_QUEUE_SIZE
+#define DAC8568_QUEUE_SIZE 16
+#endif
+#if (DAC8568_QUEUE_SIZE & (DAC8568_QUEUE_SIZE - 1)) != 0 || DAC8568_QUEUE_SIZE > 32768
+#error "DAC8568_QUEUE_SIZE must be a power of 2 not greater than 32768"
+#endif
+
+// 最多可同时注册的DAC8568设备数量 (多片DAC共用或分布在多条SPI总线上)
+#ifndef DAC8568_MAX_DEVICES
+#define DAC8568_MAX_DEVICES 4
+#endif
+
+// SPI事务跟踪: 每帧 (SYNC拉低 -> 发送 -> SYNC拉高) 记录开始时刻 (DWT->CYCCNT)、命令、地址与耗时，
+// 存入每个设备的环形缓冲区，并按命令累计最小/平均/最大耗时，用于在现场定位总线时间与延迟尖峰。
+// 0: 钩子编译为空，句柄中不含跟踪字段，没有任何开销 (默认)。
+// 1: 每帧增加两次CYCCNT读取与一次记录 (约30个周期)，DMA模式下记录在传输完成中断中完成。
+#ifndef DAC8568_TRACE
+#define DAC8568_TRACE 0
+#endif
+// 环形缓冲区的记录数 (必须为2的幂)，写满后覆盖最早的记录
+#ifndef DAC8568_TRACE_SIZE
+#define DAC8568_TRACE_SIZE 64
+#endif
+#if (DAC8568_TRACE_SIZE & (DAC8568_TRACE_SIZE - 1)) != 0 || DAC8568_TRACE_SIZE > 32768
+#error "DAC8568_TRACE_SIZE must be a power of 2 not greater than 32768"
+#endif
+#define DAC8568_TRACE_CMDS 16 // 命令位 [27:24] 的取值个数，统计按命令分类
+
+    /**
+     * @brief 影子寄存器，记录驱动已发送的命令所确定的芯片状态。
+     * @note 软件复位后 valid 置1；流式输出、CLR引脚或外部修改芯片状态后应调用
+     *       DAC8568_InvalidateShadow，此后命令不再跳过，直到下一次软件复位。
+     */
+    typedef struct
+    {
+        uint16_t input_reg[8];  // 输入寄存器
+        uint16_t dac_reg[8];    // DAC寄存器 (当前输出码)
+        uint8_t power_mode[8];  // 各通道电源模式
+        uint8_t ldac_mask;      // LDAC寄存器，bit0对应通道A
+        uint8_t clear_code;     // 清除代码寄存器
+        uint8_t ref_static;     // 静态模式内部参考: 1开启，0关闭
+        uint16_t ref_flex;      // 最近一次灵活模式参考命令的数据位
+        uint8_t valid;          // 1: 与芯片状态一致，可据此跳过冗余命令
+    } DAC8568_ShadowTypeDef;
+
+#if DAC8568_TRACE
+    /**
+     * @brief 一次SPI事务 (一帧) 的跟踪记录。
+     */
+    typedef struct
+    {
+        uint32_t start;         // SYNC拉低前的时刻 (DWT->CYCCNT)
+        uint32_t cycles;        // SYNC拉低到拉高的HCLK周期数 (DMA模式含中断响应时间)
+        uint8_t cmd;            // 命令位 [27:24]
+        uint8_t addr;           // 地址位 [23:20] (通道或 BROADCAST)
+    } DAC8568_TraceRecordTypeDef;
+
+    /**
+     * @brief 单个命令的耗时统计 (DAC8568_Trace_GetStats)。
+     */
+    typedef struct
+    {
+        uint32_t count;         // 帧数
+        uint32_t min;           // 最小耗时 (周期)，count为0时为0
+        uint32_t avg;           // 平均耗时 (周期)
+        uint32_t max;           // 最大耗时 (周期)
+        uint32_t max_start;     // 最大耗时那一帧的开始时刻，可与环形缓冲区中的记录对照
+    } DAC8568_TraceStatsTypeDef;
+
+    /**
+     * @brief 设备的跟踪状态，由发送路径写入 (每个设备同一时刻只有一个事务，不需要加锁)。
+     */
+    typedef struct
+    {
+        DAC8568_TraceRecordTypeDef ring[DAC8568_TRACE_SIZE]; // 最近的记录
+        volatile uint32_t head;                 // 累计记录数，ring[head % SIZE] 为下一条的位置
+        uint32_t start;                         // 进行中事务的开始时刻
+        uint32_t wire;                          // 进行中事务的帧 (线上顺序)
+        uint32_t count[DAC8568_TRACE_CMDS];     // 按命令累计的帧数
+        uint32_t min[DAC8568_TRACE_CMDS];
+        uint32_t max[DAC8568_TRACE_CMDS];
+        uint32_t max_start[DAC8568_TRACE_CMDS];
+        uint64_t sum[DAC8568_TRACE_CMDS];
+    } DAC8568_TraceTypeDef;
+#endif
+
+    struct __DAC8568_HandleTypeDef;
+
+    /**
+     * @brief 异步传输完成回调。
+     * @param hdac 完成传输的设备句柄。
+     * @param status HAL_OK 全部帧已发出；HAL_ERROR/HAL_TIMEOUT 传输失败，未发出的帧被放弃。
+     * @note DMA模式下在SPI发送DMA中断中调用，回调中可以直接启动下一次异步传输。
+     */
+    typedef void (*DAC8568_CallbackTypeDef)(struct __DAC8568_HandleTypeDef *hdac, HAL_StatusTypeDef status);
+
+    /**
+     * @brief DAC8568设备句柄，每片DAC对应一个。
+     * @note 由 DAC8568_Init 初始化，所有驱动函数的第一个参数。
+     */
+    typedef struct __DAC8568_HandleTypeDef
+    {
+        SPI_HandleTypeDef *hspi;        // SPI句柄指针，用于SPI通信
+        GPIO_TypeDef *sync_port;        // SYNC引脚的GPIO端口指针
+        uint16_t sync_pin;              // SYNC引脚的引脚号
+        GPIO_TypeDef *ldac_port;        // 硬件LDAC引脚的GPIO端口，NULL表示未连接 (LDAC固定为高电平)
+        uint16_t ldac_pin;              // 硬件LDAC引脚的引脚号
+        uint8_t spi16;                  // SPI数据帧宽度: 0为8位 (每帧4字节)，1为16位 (每帧2个半字)
+        uint32_t tx_buf[8];             // 发送缓冲区 (线上顺序，DMA传输期间必须保持有效)，单帧或8通道连发
+        const uint32_t *tx_next;        // 连发中下一帧的地址
+        volatile uint16_t tx_remaining; // 连发中尚未启动的帧数，在传输完成回调中递减
+        volatile uint8_t busy;          // DMA传输进行中标志，全部帧发送完成后在回调中清零
+        uint8_t streaming;              // 所在总线被流式输出引擎占用 (见DAC8568_Stream.h)
+        uint8_t skip_redundant;         // 1: 跳过不改变芯片状态的命令 (初始值为 DAC8568_SKIP_REDUNDANT)
+        uint32_t frames_skipped;        // 因冗余而跳过的帧数
+        DAC8568_ShadowTypeDef shadow;   // 影子寄存器
+        uint32_t queue[DAC8568_QUEUE_SIZE]; // 命令队列 (线上顺序帧)
+        volatile uint16_t queue_head;   // 入队计数，只由生产者 (DAC8568_Enqueue) 修改
+        volatile uint16_t queue_tail;   // 出队计数，只由消费者 (传输完成回调) 修改
+        uint8_t tx_queued;              // 当前DMA传输的帧来自命令队列，完成后才出队
+        uint32_t queue_overflows;       // 队列已满而被拒绝的帧数
+        DAC8568_CallbackTypeDef callback; // 异步传输完成回调 (见 DAC8568_RegisterCallback)
+        volatile uint8_t tx_async;      // 当前传输由异步函数启动，结束时调用回调
+        volatile HAL_StatusTypeDef last_status; // 最近一次异步传输的结果
+        uint32_t min_interval[8];       // 各通道两次更新的最小间隔 (HCLK周期数)
+        uint32_t not_before[8];         // 各通道下一次允许更新的时刻 (DWT->CYCCNT)
+        uint8_t throttle_mask;          // 设置了最小间隔的通道
+        uint8_t recovering;             // 软件复位恢复期内
+        uint32_t ready_at;              // 复位恢复结束的时刻 (DWT->CYCCNT)
+        uint32_t ext_ref_uv;            // 外部参考电压 (μV)
+        uint8_t output_gain;            // 输出缓冲增益 (1或2)
+        uint8_t scale_ref;              // uv_to_code 对应的参考: 1内部，0外部，0xFF需要重新计算
+        uint32_t uv_to_code;            // μV→码值的倒数系数 (Q32)，参考或增益改变时重新计算
+#if DAC8568_TRACE
+        DAC8568_TraceTypeDef trace;     // SPI事务跟踪 (见 DAC8568_TRACE)
+#endif
+    } DAC8568_HandleTypeDef;
+
+// 32位帧编码 (参考数据手册第35页表4)
+// 编码结果为数值形式: DB31位于uint32_t的最高位，可用于常量表初始化。
+#define DAC8568_FRAME(cmd, addr, data, feature)                              \
+    (((uint32_t)((cmd) & 0x0F) << 24) | ((uint32_t)((addr) & 0x0F) << 20) | \
+     ((uint32_t)((data) & 0xFFFF) << 4) | (uint32_t)((feature) & 0x0F))
+
+    /**
+     * @brief 将命令、地址、数据和特征位编码为一个32位帧。
+     * @param cmd 4位命令位 (DB27-DB24)。
+     * @param addr 4位地址位 (DB23-DB20)。
+     * @param data 16位数据位 (DB19-DB4)。
+     * @param feature 4位特征位 (DB3-DB0)。
+     * @retval 数值形式的帧，前缀位 (DB31-DB28) 固定为0。
+     * @note 参数为常量时编译期即可折叠为立即数。
+     */
+    static inline uint32_t DAC8568_EncodeFrame(uint8_t cmd, uint8_t addr, uint16_t data, uint8_t feature)
+    {
+        return DAC8568_FRAME(cmd, addr, data, feature);
+    }
+
+// 原生分辨率码值 → 16位数据位: 超出满量程时限幅，再左移到D15对齐。
+// DAC8568的码值即数据位，不产生任何指令。
+#if DAC8568_DATA_SHIFT == 0
+#define DAC8568_CODE_TO_DATA(code) ((uint16_t)(code))
+#else
+#define DAC8568_CODE_TO_DATA(code) \
+    ((uint16_t)((((uint32_t)(code) > DAC8568_MAX_CODE) ? DAC8568_MAX_CODE : (uint32_t)(code)) << DAC8568_DATA_SHIFT))
+#endif
+
+// 16位数据位 → 原生分辨率码值
+#define DAC8568_DATA_TO_CODE(data) ((uint16_t)((data) >> DAC8568_DATA_SHIFT))
+
+// 写入码值的帧 (特征位为0)，code为原生分辨率
+#define DAC8568_CODE_FRAME(cmd, addr, code) DAC8568_FRAME(cmd, addr, DAC8568_CODE_TO_DATA(code), 0)
+
+    /**
+     * @brief 将命令、地址和原生分辨率码值编码为一个32位帧。
+     * @param cmd 4位命令位 (如 CMD_WRITE_INPUT_UPDATE_ONE)。
+     * @param addr 4位地址位 (通道或 BROADCAST)。
+     * @param code 码值 (DAC7568: 0~4095，DAC8168: 0~16383，DAC8568: 0~65535)，超出范围时限幅。
+     * @retval 数值形式的帧。
+     */
+    static inline uint32_t DAC8568_EncodeCode(uint8_t cmd, uint8_t addr, uint16_t code)
+    {
+        return DAC8568_CODE_FRAME(cmd, addr, code);
+    }
+
+    /**
+     * @brief 将数值形式的帧转换为SPI发送顺序 (DB31-DB24字节位于最低地址)。
+     * @param frame 数值形式的帧。
+     * @retval 可直接作为4字节缓冲区发送的帧。Cortex-M3上编译为一条REV指令。
+     */
+    static inline uint32_t DAC8568_FrameToWire(uint32_t frame)
+    {
+        return __REV(frame);
+    }
+
+// 16位SPI数据帧的发送顺序: 低地址半字为DB31-DB16，高地址半字为DB15-DB0
+#define DAC8568_FRAME_TO_HALFWORDS(frame) ((uint32_t)(((frame) << 16) | ((frame) >> 16)))
+
+    /**
+     * @brief 将数值形式的帧转换为16位SPI的发送顺序 (DB31-DB16半字位于低地址)。
+     * @param frame 数值形式的帧。
+     * @retval 可直接作为2个半字发送的帧。Cortex-M3上编译为一条ROR指令。
+     */
+    static inline uint32_t DAC8568_FrameToHalfWords(uint32_t frame)
+    {
+        return DAC8568_FRAME_TO_HALFWORDS(frame);
+    }
+
     // 函数声明
-    void DAC8568_Init(SPI_HandleTypeDef *hspi, GPIO_TypeDef *sync_port, uint16_t sync_pin);
-    void DAC8568_Write(uint8_t channel, uint16_t data);
-    void DAC8568_Update(uint8_t channel);
-    void DAC8568_WriteAndUpdate(uint8_t channel, uint16_t data);
-    void DAC8568_WriteAllChannels(uint16_t *data);
-    void DAC8568_UpdateAllChannels(void);
-    void DAC8568_SetPowerMode(uint8_t channel, uint8_t mode);
-    void DAC8568_EnableStaticInternalRef(void);
-    void DAC8568_DisableStaticInternalRef(void);
-    void DAC8568_EnableFlexMode(void);
-    void DAC8568_DisableFlexMode(void);
-    void DAC8568_SetFlexModeRefAlwaysOn(uint8_t enable);
-    void DAC8568_SetFlexModeRefAlwaysOff(uint8_t enable);
-    void DAC8568_SetClearCode(uint8_t mode);
-    void DAC8568_SoftwareReset(void);
-    void DAC8568_SendRawCommand(uint8_t cmd_bits, uint8_t addr_bits, uint16_t data_bits, uint8_t feature_bits);
-    void DAC8568_SendRawData(uint8_t raw_data[4]);
+    void DAC8568_Init(DAC8568_HandleTypeDef *hdac, SPI_HandleTypeDef *hspi, GPIO_TypeDef *sync_port, uint16_t sync_pin);
+    void DAC8568_Write(DAC8568_HandleTypeDef *hdac, uint8_t channel, uint16_t data);
+    void DAC8568_Update(DAC8568_HandleTypeDef *hdac, uint8_t channel);
+    void DAC8568_WriteAndUpdate(DAC8568_HandleTypeDef *hdac, uint8_t channel, uint16_t data);
+    void DAC8568_WriteAllChannels(DAC8568_HandleTypeDef *hdac, uint16_t *data);
+    void DAC8568_WriteAndUpdateAllChannels(DAC8568_HandleTypeDef *hdac, const uint16_t *data);
+    void DAC8568_UpdateAllChannels(DAC8568_HandleTypeDef *hdac);
+    void DAC8568_SetPowerMode(DAC8568_HandleTypeDef *hdac, uint8_t channel, uint8_t mode);
+    void DAC8568_EnableStaticInternalRef(DAC8568_HandleTypeDef *hdac);
+    void DAC8568_DisableStaticInternalRef(DAC8568_HandleTypeDef *hdac);
+    void DAC8568_EnableFlexMode(DAC8568_HandleTypeDef *hdac);
+    void DAC8568_DisableFlexMode(DAC8568_HandleTypeDef *hdac);
+    void DAC8568_SetFlexModeRefAlwaysOn(DAC8568_HandleTypeDef *hdac, uint8_t enable);
+    void DAC8568_SetFlexModeRefAlwaysOff(DAC8568_HandleTypeDef *hdac, uint8_t enable);
+    void DAC8568_SetClearCode(DAC8568_HandleTypeDef *hdac, uint8_t mode);
+    void DAC8568_SetLdacMask(DAC8568_HandleTypeDef *hdac, uint8_t mask);
+    void DAC8568_AttachLdacPin(DAC8568_HandleTypeDef *hdac, GPIO_TypeDef *ldac_port, uint16_t ldac_pin);
+    void DAC8568_PulseLdac(DAC8568_HandleTypeDef *hdac);
+    void DAC8568_SoftwareReset(DAC8568_HandleTypeDef *hdac);
+    void DAC8568_SendRawCommand(DAC8568_HandleTypeDef *hdac, uint8_t cmd_bits, uint8_t addr_bits, uint16_t data_bits, uint8_t feature_bits);
+    void DAC8568_SendRawData(DAC8568_HandleTypeDef *hdac, uint8_t raw_data[4]);
+    void DAC8568_EncodeFrames(DAC8568_HandleTypeDef *hdac, uint32_t *frames, uint8_t cmd_bits, uint8_t channel, const uint16_t *data, uint16_t count);
+    void DAC8568_SendFrames(DAC8568_HandleTypeDef *hdac, const uint32_t *frames, uint16_t count);
+
+    // 影子寄存器查询
+    const DAC8568_ShadowTypeDef *DAC8568_GetShadow(DAC8568_HandleTypeDef *hdac);
+    uint16_t DAC8568_GetInputCode(DAC8568_HandleTypeDef *hdac, uint8_t channel);
+    uint16_t DAC8568_GetOutputCode(DAC8568_HandleTypeDef *hdac, uint8_t channel);
+    uint8_t DAC8568_GetPowerMode(DAC8568_HandleTypeDef *hdac, uint8_t channel);
+    uint8_t DAC8568_GetLdacMask(DAC8568_HandleTypeDef *hdac);
+    void DAC8568_InvalidateShadow(DAC8568_HandleTypeDef *hdac);
+    void DAC8568_SetBusStreaming(SPI_HandleTypeDef *hspi, uint8_t streaming);
+
+    // 电压设定
+    void DAC8568_SetExternalRef(DAC8568_HandleTypeDef *hdac, uint32_t microvolts);
+    void DAC8568_SetOutputGain(DAC8568_HandleTypeDef *hdac, uint8_t gain);
+    uint32_t DAC8568_GetFullScaleMicrovolts(DAC8568_HandleTypeDef *hdac);
+    uint16_t DAC8568_MicrovoltsToCode(DAC8568_HandleTypeDef *hdac, uint32_t microvolts);
+    void DAC8568_SetMicrovolts(DAC8568_HandleTypeDef *hdac, uint8_t channel, uint32_t microvolts);
+    void DAC8568_SetMillivolts(DAC8568_HandleTypeDef *hdac, uint8_t channel, uint32_t millivolts);
+    void DAC8568_SetMillivoltsAllChannels(DAC8568_HandleTypeDef *hdac, const uint32_t *millivolts);
+
+    // 时序控制
+    void DAC8568_Time_Init(void);
+    uint32_t DAC8568_UsToCycles(uint32_t us);
+    void DAC8568_DelayUs(uint32_t us);
+    void DAC8568_SetMinInterval(DAC8568_HandleTypeDef *hdac, uint8_t channel, uint32_t us);
+
+    // 异步接口: 立即返回，设备忙时返回 HAL_BUSY，传输结束时调用注册的回调
+    void DAC8568_RegisterCallback(DAC8568_HandleTypeDef *hdac, DAC8568_CallbackTypeDef callback);
+    HAL_StatusTypeDef DAC8568_Write_Async(DAC8568_HandleTypeDef *hdac, uint8_t channel, uint16_t data);
+    HAL_StatusTypeDef DAC8568_WriteAndUpdate_Async(DAC8568_HandleTypeDef *hdac, uint8_t channel, uint16_t data);
+    HAL_StatusTypeDef DAC8568_WriteAndUpdateAllChannels_Async(DAC8568_HandleTypeDef *hdac, const uint16_t *data);
+    HAL_StatusTypeDef DAC8568_SendFrames_Async(DAC8568_HandleTypeDef *hdac, const uint32_t *frames, uint16_t count);
+    HAL_StatusTypeDef DAC8568_TrySendFrames(DAC8568_HandleTypeDef *hdac, const uint32_t *frames, uint16_t count);
+    HAL_StatusTypeDef DAC8568_GetLastStatus(DAC8568_HandleTypeDef *hdac);
+
+    // 命令队列
+    uint8_t DAC8568_Enqueue(DAC8568_HandleTypeDef *hdac, uint32_t frame);
+    uint16_t DAC8568_GetQueueCount(DAC8568_HandleTypeDef *hdac);
+
+    // DMA传输控制
+    uint8_t DAC8568_IsBusy(DAC8568_HandleTypeDef *hdac);
+    void DAC8568_WaitForTransfer(DAC8568_HandleTypeDef *hdac);
+    void DAC8568_TxCpltCallback(SPI_HandleTypeDef *hspi);
+    void DAC8568_ErrorCallback(SPI_HandleTypeDef *hspi);
+
+#if DAC8568_TRACE
+    // SPI事务跟踪
+    void DAC8568_Trace_Reset(DAC8568_HandleTypeDef *hdac);
+    void DAC8568_Trace_GetStats(DAC8568_HandleTypeDef *hdac, DAC8568_TraceStatsTypeDef stats[DAC8568_TRACE_CMDS]);
+    uint16_t DAC8568_Trace_Read(DAC8568_HandleTypeDef *hdac, DAC8568_TraceRecordTypeDef *records, uint16_t max);
+#endif
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,71 @@
+/*
+ * DAC8568 驱动性能测试
+ * 作者: 雪豹
+ */
+/*
+ * 测量方法:
+ * ----------------------------------------------------------------
+ * 每个驱动入口函数连续调用 DAC8568_BENCH_ITERATIONS 次，最后等待DMA传输结束，
+ * 用 DWT->CYCCNT 计量总耗时。只有在目标板上运行时结果才是实测值。
+ *
+ * 主机仿真中同一份代码也能运行，DWT由虚拟时钟驱动: HAL替身按 Host/Inc/host_sim.h 的固定开销
+ * (HOST_CYCLES_*) 与SPI移位时间推进，驱动代码按执行的基本块数计入 (HOST_CYCLES_BLOCK)。
+ * 主机上的结果是估计值，各入口之间的差别与热路径的性能回退可以看出，绝对值以目标板为准。
+ *
+ * 结果字段:
+ *   cycles_per_call   每次调用的CPU周期数 (含DMA模式下等待传输完成的时间)
+ *   cycles_per_frame  每个SPI帧的CPU周期数
+ *   frames_per_sec    按HCLK换算的帧速率
+ *   bus_permille      总线利用率 (千分比) = 32位×帧数×每位周期数 / 总耗时，
+ *                     1000表示SCLK连续不断，低于此值的部分为SYNC、HAL和中断开销
+ *
+ * 注意: 测试会向DAC发送真实的命令帧，改变输出电压、电源模式和清除代码寄存器，
+ *       结束后所有通道为上电状态。
+ */
+
+#ifndef DAC8568_BENCH_H
+#define DAC8568_BENCH_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "DAC8568.h"
+
+// 每个入口函数的调用次数
+#ifndef DAC8568_BENCH_ITERATIONS
+#define DAC8568_BENCH_ITERATIONS 256
+#endif
+
+// 测试项数量 (DAC8568_Bench_Run 输出结果数组的最小长度)
+#define DAC8568_BENCH_COUNT 16
+
+    /**
+     * @brief 单个入口函数的测试结果。
+     */
+    typedef struct
+    {
+        const char *name;          // 入口函数名
+        uint32_t calls;            // 调用次数
+        uint32_t frames;           // 发送的SPI帧总数
+        uint32_t cycles;           // 总CPU周期数
+        uint32_t cycles_per_call;  // 每次调用的CPU周期数
+        uint32_t cycles_per_frame; // 每帧CPU周期数
+        uint32_t frames_per_sec;   // 帧速率 (帧/秒)
+        uint32_t bus_permille;     // 总线利用率 (千分比)
+    } DAC8568_BenchResultTypeDef;
+
+    // 函数声明
+    void DAC8568_Bench_EnableCycleCounter(void);
+    uint32_t DAC8568_Bench_GetBitCycles(const DAC8568_HandleTypeDef *hdac);
+    uint8_t DAC8568_Bench_Run(DAC8568_HandleTypeDef *hdac, DAC8568_BenchResultTypeDef *results);
+    void DAC8568_Bench_Print(const DAC8568_BenchResultTypeDef *results, uint8_t count);
+#if DAC8568_TRACE
+    void DAC8568_Bench_PrintTrace(DAC8568_HandleTypeDef *hdac);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* DAC8568_BENCH_H */
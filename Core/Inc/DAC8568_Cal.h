@@ -0,0 +1,82 @@
+/*
+ * DAC8568 通道校准 (增益/失调，Q16定点)
+ * 作者: 雪豹
+ */
+/*
+ * 原理:
+ * ----------------------------------------------------------------
+ * 每个通道一组Q16定点系数，写入前把目标码值修正为实际发送的码值:
+ *   输出码 = (码值 × gain + offset + 0.5) >> 16，饱和到 0 ~ DAC8568_MAX_CODE
+ *   gain   Q16增益，65536 = 1.0 (范围约 0 ~ 32767.99)
+ *   offset Q16失调，单位为码值，65536 = 1个LSB，可为负
+ * Cortex-M3上每个样本为一次SMULL、一次加法、一次移位和两次比较，没有除法与软浮点调用。
+ *
+ * 两点校准:
+ *   写入 code1、code2 两个码值，测得实际输出对应的码值 actual1、actual2 (例如用万用表测电压后换算)，
+ *   DAC8568_Cal_TwoPoint 计算使输出等于目标码值的 gain 与 offset (只在设置时做一次64位除法)。
+ */
+
+#ifndef DAC8568_CAL_H
+#define DAC8568_CAL_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "DAC8568.h"
+
+#define DAC8568_CAL_ONE 65536 // Q16的1.0
+
+    /**
+     * @brief 单个通道的校准系数。
+     */
+    typedef struct
+    {
+        int32_t gain;   // Q16增益
+        int32_t offset; // Q16失调 (码值)
+    } DAC8568_CalChannelTypeDef;
+
+    /**
+     * @brief 一片DAC的8个通道的校准表。
+     */
+    typedef struct
+    {
+        DAC8568_CalChannelTypeDef ch[8];
+    } DAC8568_CalTypeDef;
+
+    /**
+     * @brief 对一个码值做增益/失调修正。
+     * @param c 通道校准系数。
+     * @param code 目标码值 (原生分辨率)。
+     * @retval 修正并饱和后的码值。
+     */
+    static inline uint16_t DAC8568_Cal_Apply(const DAC8568_CalChannelTypeDef *c, uint16_t code)
+    {
+        int64_t x = (int64_t)code * c->gain + c->offset + 0x8000; // 四舍五入
+        int64_t y = x >> 16; // 先在64位中饱和再缩窄，大增益 × 码值超出int32时不回绕
+        if (y < 0)
+        {
+            return 0;
+        }
+        if (y > (int64_t)DAC8568_MAX_CODE)
+        {
+            return (uint16_t)DAC8568_MAX_CODE;
+        }
+        return (uint16_t)y;
+    }
+
+    // 函数声明
+    void DAC8568_Cal_Init(DAC8568_CalTypeDef *cal);
+    void DAC8568_Cal_Set(DAC8568_CalTypeDef *cal, uint8_t channel, int32_t gain, int32_t offset);
+    void DAC8568_Cal_TwoPoint(DAC8568_CalTypeDef *cal, uint8_t channel, uint16_t code1, uint16_t actual1,
+                              uint16_t code2, uint16_t actual2);
+    void DAC8568_Cal_ApplyAll(const DAC8568_CalTypeDef *cal, const uint16_t *in, uint16_t *out);
+    void DAC8568_Cal_Write(DAC8568_HandleTypeDef *hdac, const DAC8568_CalTypeDef *cal, uint8_t channel, uint16_t code);
+    void DAC8568_Cal_WriteAndUpdate(DAC8568_HandleTypeDef *hdac, const DAC8568_CalTypeDef *cal, uint8_t channel, uint16_t code);
+    void DAC8568_Cal_WriteAndUpdateAllChannels(DAC8568_HandleTypeDef *hdac, const DAC8568_CalTypeDef *cal, const uint16_t *data);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* DAC8568_CAL_H */
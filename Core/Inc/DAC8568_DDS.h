@@ -0,0 +1,98 @@
+/*
+ * DAC8568 直接数字频率合成 (DDS) 引擎
+ * 作者: 雪豹
+ */
+/*
+ * 原理:
+ * ----------------------------------------------------------------
+ * 每个通道一个32位相位累加器，每个采样加上该通道的频率控制字 (tuning word)：
+ *   输出频率 = tuning × 采样率 / 2^32，频率分辨率 = 采样率 / 2^32
+ *   (采样率100kHz时约23μHz)
+ *
+ * 波形:
+ *   正弦     512点Q15正弦表 (存放在Flash)，相位低位做线性插值
+ *   三角/锯齿/方波  由相位直接计算，结果精确，不需要查表
+ *   任意波形  用户提供的Flash表 (2^n点，n为1~16，Q15)，同样线性插值
+ * 输出码 = offset + (样本 × amplitude) >> 15，饱和到0~65535。
+ * amplitude、offset与样本均以16位满量程表示，与 DAC8568_DEVICE 选择的型号无关。
+ * 采样路径只有整数加法、移位和一次乘法，不使用浮点运算。
+ *
+ * 输出方式:
+ * 1. 流式输出: DAC8568_DDS_Render 把已启用通道轮流编码为流式帧 (DAC8568_STREAM_FRAME 格式)，
+ *    每组的最后一帧使用 CMD_WRITE_INPUT_UPDATE_ALL，同组各通道同时更新。
+ *    在流式缓冲区的DMA半传输/传输完成时刻渲染空闲的一半即可连续输出。
+ *    配合定时LDAC (DAC8568_Stream_SetLdacStrobe) 时用 DAC8568_DDS_SetLdacStrobe 改为只写输入寄存器。
+ * 2. 定时器中断: 每个采样周期调用 DAC8568_DDS_Step 得到8个通道的码值，
+ *    再用 DAC8568_WriteAndUpdateAllChannels 发送 (DMA连发，中断中不等待)。
+ */
+
+#ifndef DAC8568_DDS_H
+#define DAC8568_DDS_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "DAC8568.h"
+
+// 正弦表点数 (2的幂)
+#define DAC8568_DDS_SINE_BITS 9
+#define DAC8568_DDS_SINE_SIZE (1U << DAC8568_DDS_SINE_BITS)
+
+    /**
+     * @brief DDS波形类型。
+     */
+    typedef enum
+    {
+        DAC8568_DDS_OFF = 0,    // 通道不参与输出
+        DAC8568_DDS_SINE,       // 正弦
+        DAC8568_DDS_TRIANGLE,   // 三角波
+        DAC8568_DDS_SAW,        // 锯齿波 (上升)
+        DAC8568_DDS_SQUARE,     // 方波 (占空比50%)
+        DAC8568_DDS_TABLE       // 用户波形表
+    } DAC8568_DDS_WaveTypeDef;
+
+    /**
+     * @brief 单个通道的振荡器参数与状态。
+     */
+    typedef struct
+    {
+        uint32_t phase;         // 相位累加器
+        uint32_t tuning;        // 频率控制字
+        uint16_t amplitude;     // 峰值幅度 (码值，0~32767)
+        uint16_t offset;        // 中心码值
+        uint8_t wave;           // DAC8568_DDS_WaveTypeDef
+        uint8_t table_bits;     // 用户表点数的log2 (1~16)
+        const int16_t *table;   // 用户表 (Q15，建议为const以存放在Flash)
+    } DAC8568_DDS_ChannelTypeDef;
+
+    /**
+     * @brief DDS引擎，8个通道共用一个采样时钟。
+     */
+    typedef struct
+    {
+        DAC8568_DDS_ChannelTypeDef ch[8];
+        uint8_t order[8];       // 已启用通道的发送顺序
+        uint8_t active;         // 已启用通道数
+        uint8_t slot;           // 流式渲染时当前组内的位置
+        uint8_t update_cmd;     // 每组最后一帧的命令 (定时LDAC时为 CMD_WRITE_INPUT_REG)
+    } DAC8568_DDS_HandleTypeDef;
+
+    // 函数声明
+    void DAC8568_DDS_Init(DAC8568_DDS_HandleTypeDef *dds);
+    uint32_t DAC8568_DDS_TuningWord(uint32_t freq_mhz, uint32_t sample_rate);
+    void DAC8568_DDS_SetChannel(DAC8568_DDS_HandleTypeDef *dds, uint8_t channel, DAC8568_DDS_WaveTypeDef wave,
+                                uint32_t tuning, uint16_t amplitude, uint16_t offset);
+    void DAC8568_DDS_SetTable(DAC8568_DDS_HandleTypeDef *dds, uint8_t channel, const int16_t *table, uint8_t table_bits);
+    void DAC8568_DDS_SetPhase(DAC8568_DDS_HandleTypeDef *dds, uint8_t channel, uint32_t phase);
+    uint16_t DAC8568_DDS_Sample(DAC8568_DDS_ChannelTypeDef *osc);
+    void DAC8568_DDS_Step(DAC8568_DDS_HandleTypeDef *dds, uint16_t codes[8]);
+    void DAC8568_DDS_SetLdacStrobe(DAC8568_DDS_HandleTypeDef *dds, uint8_t enable);
+    void DAC8568_DDS_Render(DAC8568_DDS_HandleTypeDef *dds, uint32_t *frames, uint16_t count);
+    void DAC8568_DDS_Generator(void *context, uint32_t *frames, uint16_t count);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* DAC8568_DDS_H */
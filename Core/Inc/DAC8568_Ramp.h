@@ -0,0 +1,72 @@
+/*
+ * DAC8568 斜率限制斜坡发生器
+ * 作者: 雪豹
+ */
+/*
+ * 原理:
+ * ----------------------------------------------------------------
+ * 每个通道保存当前位置与目标位置 (Q16码值) 和斜率 (Q16码值/节拍)。
+ * 定时器中断每个节拍调用一次 DAC8568_Ramp_Tick:
+ *   1. 仍在运动的通道向目标前进一个斜率，最后一步恰好停在目标上；
+ *   2. 输出码 (四舍五入) 有变化的通道编码为一帧，全部放进一次DMA连发:
+ *      前面的帧只写输入寄存器，最后一帧 CMD_WRITE_INPUT_UPDATE_ALL 同时更新，
+ *      与 DAC8568_WriteAndUpdateAllChannels 相同；
+ *   3. 已到达目标或码值未变化的通道不发送帧，全部静止时不占用总线。
+ * 斜率小于1码值/节拍时按Q16小数累加，只在码值变化的节拍发送。
+ * 每个节拍的运算只有加减与比较，应用程序只需设定目标，不必轮询或逐步发送。
+ *
+ * 上一次连发尚未结束或总线被占用时本节拍不前进 (顺延一个节拍)，计入 late_ticks。
+ * 运动状态由位置与目标是否相等得出，没有主循环与中断共同修改的标志位，
+ * 主循环中可以随时调用 DAC8568_Ramp_SetTarget；同一设备的其它驱动调用仍须遵守
+ * 单一上下文的限制 (见命令队列的说明)。
+ */
+
+#ifndef DAC8568_RAMP_H
+#define DAC8568_RAMP_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "DAC8568.h"
+
+// 斜率: 每节拍的码值数 (Q16)，例如 DAC8568_RAMP_RATE(4) 为每节拍4个码值
+#define DAC8568_RAMP_RATE(codes) ((uint32_t)(codes) << 16)
+
+    /**
+     * @brief 单个通道的斜坡状态。
+     */
+    typedef struct
+    {
+        uint32_t position;      // 当前位置 (Q16码值)
+        uint32_t target;        // 目标位置 (Q16码值)
+        uint32_t rate;          // 斜率 (Q16码值/节拍)，0表示直接跳到目标
+        uint16_t code;          // 最近一次发送的码值
+    } DAC8568_Ramp_ChannelTypeDef;
+
+    /**
+     * @brief 一片DAC的斜坡发生器。
+     */
+    typedef struct
+    {
+        DAC8568_HandleTypeDef *hdac;
+        DAC8568_Ramp_ChannelTypeDef ch[8];
+        uint32_t frames[8];     // 连发缓冲区 (线上顺序，DMA传输期间保持有效)
+        uint32_t late_ticks;    // 上一次连发尚未结束、顺延到下一节拍的次数
+    } DAC8568_RampTypeDef;
+
+    // 函数声明
+    void DAC8568_Ramp_Init(DAC8568_RampTypeDef *ramp, DAC8568_HandleTypeDef *hdac);
+    void DAC8568_Ramp_SetPosition(DAC8568_RampTypeDef *ramp, uint8_t channel, uint16_t code);
+    void DAC8568_Ramp_SetTarget(DAC8568_RampTypeDef *ramp, uint8_t channel, uint16_t code, uint32_t rate);
+    void DAC8568_Ramp_SetTargetIn(DAC8568_RampTypeDef *ramp, uint8_t channel, uint16_t code, uint32_t ticks);
+    void DAC8568_Ramp_Stop(DAC8568_RampTypeDef *ramp, uint8_t channel);
+    HAL_StatusTypeDef DAC8568_Ramp_Tick(DAC8568_RampTypeDef *ramp);
+    uint8_t DAC8568_Ramp_GetMoving(const DAC8568_RampTypeDef *ramp);
+    uint16_t DAC8568_Ramp_GetCode(const DAC8568_RampTypeDef *ramp, uint8_t channel);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* DAC8568_RAMP_H */
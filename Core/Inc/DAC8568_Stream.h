@@ -0,0 +1,124 @@
+/*
+ * DAC8568 硬件定时流式输出引擎
+ * 作者: 雪豹
+ */
+/*
+ * 工作原理 (无需CPU参与每个采样):
+ * ----------------------------------------------------------------
+ * TIM3 以帧速率周期计数，四个定时器事件各触发一次DMA请求：
+ *
+ *   事件         | DMA通道      | 传输内容
+ *   -------------|-------------|------------------------------------
+ *   TIM3_CH1比较 | DMA1通道6   | GPIO BSRR <- SYNC复位位 (拉低SYNC)
+ *   TIM3_UP更新  | DMA1通道3   | SPI1->DR  <- 帧高16位 (DB31-DB16)
+ *   TIM3_CH4比较 | DMA1通道3   | SPI1->DR  <- 帧低16位 (DB15-DB0)
+ *   TIM3_CH3比较 | DMA1通道2   | GPIO BSRR <- SYNC置位位 (拉高SYNC)
+ *
+ * TIM3_UP与TIM3_CH4在DMA1通道3上为"或"关系，两个请求依次搬运同一循环缓冲区中
+ * 相邻的两个半字，因此SPI1在流式输出期间工作在16位数据帧模式。
+ * 一个周期内的时序 (计数值):
+ *
+ *   0            CC4           CC3                 CC1     ARR
+ *   |UP:写高半字 |写低半字      |SYNC拉高            |SYNC拉低|
+ *   |<---- 32个SCLK (SPI移位) ---->|                 |<-lead->|
+ *
+ * 采样时序完全由定时器晶振决定，DMA仲裁延迟只影响帧内SCLK的起始点，
+ * 不会累积到采样间隔上。
+ *
+ * 资源占用: TIM3, DMA1通道2/3/6, SPI1。通道3与普通DMA发送共用，
+ * 流式输出期间SPI1上所有已注册设备的普通命令函数都会直接丢弃帧 (DAC8568_SetBusStreaming)，
+ * hspi1的HAL状态保持为 HAL_SPI_STATE_BUSY_TX，直接调用HAL发送的代码得到 HAL_BUSY。
+ *
+ * 乒乓缓冲 (DAC8568_Stream_StartPingPong):
+ * ----------------------------------------------------------------
+ * 循环缓冲区分为前后两半，DMA1通道3的半传输 (HT) 与传输完成 (TC) 中断分别在DMA进入
+ * 后半/前半时触发，中断中调用生成函数填充DMA刚播放完的那一半:
+ *
+ *   DMA位置:   [====前半====|----后半----]  HT: 填充前半
+ *              [----前半----|====后半====]  TC: 填充后半
+ *
+ * CPU工作按半个缓冲区的时长成批进行。生成函数必须在半个缓冲区播放完之前返回
+ * (DAC8568_Stream_GetRefillBudget)，否则DMA会播放尚未更新的旧数据，计为一次欠载
+ * (DAC8568_Stream_GetUnderruns)。需要在 DMA1_Channel3_IRQHandler 中先调用 DAC8568_Stream_IRQHandler。
+ *
+ * 定时LDAC (DAC8568_Stream_SetLdacStrobe):
+ * ----------------------------------------------------------------
+ * 普通方式下每组最后一帧的更新命令在该帧移位完成时生效，输出时刻随DMA仲裁延迟抖动。
+ * 定时LDAC方式下所有帧只写输入寄存器，TIM4以TIM3的TRGO触发同时启动，
+ * 周期为整组帧，CH1 (PB6) 在组内最后一帧锁存之后输出LDAC低脉冲，8个通道同时更新:
+ *
+ *   帧:     | A | B | ... | H | A | B | ...
+ *   LDAC:   ‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾|_|‾‾‾‾‾‾‾‾‾‾
+ *                             ^ 组内最后一帧锁存之后 DAC8568_STREAM_LDAC_DELAY
+ *
+ * 两个定时器使用同一计数时钟，采样时刻只由晶振决定；DMA在两次脉冲之间装入下一组输入寄存器。
+ * 额外资源: TIM4，PB6 (TIM4_CH1，输出期间切换为复用功能)。
+ */
+
+#ifndef DAC8568_STREAM_H
+#define DAC8568_STREAM_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "DAC8568.h"
+
+// 流式缓冲区帧格式: DMA按内存顺序先发送低地址半字 (DB31-DB16)，
+// 与16位SPI模式下的普通发送顺序相同 (Cortex-M3上为一条ROR指令)。
+#define DAC8568_FRAME_TO_STREAM(frame) DAC8568_FRAME_TO_HALFWORDS(frame)
+#define DAC8568_STREAM_FRAME(cmd, addr, data, feature) \
+    DAC8568_FRAME_TO_STREAM(DAC8568_FRAME(cmd, addr, data, feature))
+
+// 帧内时序参数 (定时器时钟周期数，TIM3时钟72MHz)
+#define DAC8568_STREAM_SYNC_LEAD 8    // SYNC拉低到第一个半字写入的提前量
+#define DAC8568_STREAM_LO_OFFSET 16   // 更新事件到写入低半字的延时
+#define DAC8568_STREAM_DMA_MARGIN 32  // 32位移位结束到拉高SYNC之间为DMA仲裁预留的余量
+#define DAC8568_STREAM_SYNC_HIGH_MIN 4 // SYNC最短高电平时间
+#define DAC8568_STREAM_LDAC_DELAY 8   // 组内最后一帧锁存到LDAC脉冲的延时
+#define DAC8568_STREAM_LDAC_WIDTH 8   // LDAC低电平宽度 (约110ns)
+#define DAC8568_STREAM_LDAC_HEADROOM 32 // 定时LDAC时TIM4第一个周期比整组长 delay + width，计算预分频时预留
+
+// 定时LDAC的输出引脚: TIM4_CH1，不重映射时固定为PB6
+#define DAC8568_STREAM_LDAC_PORT GPIOB
+#define DAC8568_STREAM_LDAC_PIN GPIO_PIN_6
+
+    /**
+     * @brief 乒乓缓冲的生成函数: 向 frames 写入 count 个流式帧。
+     * @note 在DMA中断中调用。DAC8568_DDS_Generator 与 DAC8568_Wave_Generator 可直接使用。
+     */
+    typedef void (*DAC8568_Stream_GeneratorTypeDef)(void *context, uint32_t *frames, uint16_t count);
+
+    /**
+     * @brief 计算定时LDAC的TIM4初始状态。
+     * @param group_ticks 一组帧的计数周期 (TIM4稳态的 ARR + 1)。
+     * @param delay 组内最后一帧锁存 (第 group_ticks - 1 个计数) 到LDAC下降沿的计数。
+     * @param width LDAC低电平宽度 (CCR1，PWM模式1下 CNT < width 时为低)。
+     * @param cnt 输出: TIM4->CNT 初值，等于 width，启动时LDAC为高电平。
+     * @retval 第一个周期的ARR。ARR开启预装载，第一次回绕后切换为 group_ticks - 1，
+     *         第一个下降沿在 group_ticks - 1 + delay，此前没有LDAC脉冲。
+     */
+    static inline uint32_t DAC8568_Stream_LdacFirstReload(uint32_t group_ticks, uint32_t delay, uint32_t width, uint32_t *cnt)
+    {
+        *cnt = width;
+        return group_ticks + delay + width - 2U; // 从 width 数到该值再回绕共 group_ticks - 1 + delay 个计数
+    }
+
+    // 函数声明
+    HAL_StatusTypeDef DAC8568_Stream_Start(DAC8568_HandleTypeDef *hdac, const uint32_t *frames, uint16_t count, uint32_t frame_rate);
+    HAL_StatusTypeDef DAC8568_Stream_StartPingPong(DAC8568_HandleTypeDef *hdac, uint32_t *frames, uint16_t count, uint32_t frame_rate,
+                                                   DAC8568_Stream_GeneratorTypeDef generator, void *context);
+    uint8_t DAC8568_Stream_IRQHandler(void);
+    uint32_t DAC8568_Stream_GetUnderruns(void);
+    uint32_t DAC8568_Stream_GetRefillCycles(void);
+    uint32_t DAC8568_Stream_GetRefillBudget(void);
+    HAL_StatusTypeDef DAC8568_Stream_SetLdacStrobe(uint8_t group);
+    void DAC8568_Stream_Stop(void);
+    uint8_t DAC8568_Stream_IsRunning(void);
+    uint32_t DAC8568_Stream_GetMaxFrameRate(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* DAC8568_STREAM_H */
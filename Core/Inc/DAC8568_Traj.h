@@ -0,0 +1,88 @@
+/*
+ * DAC8568 S曲线 (加加速度受限) 轨迹规划
+ * 作者: 雪豹
+ */
+/*
+ * 原理:
+ * ----------------------------------------------------------------
+ * 一次运动分为7段，加加速度 (jerk) 依次为 +J, 0, -J, 0, -J, 0, +J，
+ * 段长为 n1, n2, n1, n4, n1, n2, n1 个采样 (4·n1 + 2·n2 + n4 = 总采样数，n4为0或1):
+ *
+ *   加速度:   /‾‾‾‾\            (加速)
+ *                   \____/      (减速)
+ *   速度:     平滑上升到峰值后平滑下降，位置为S形
+ *
+ * 规划 (DAC8568_Traj_Plan，只执行一次):
+ *   总时长固定时不需要匀速段，峰值速度恒为 2D/T；n1越大加加速度越小、加速度越大。
+ *   在加速度不超过上限的前提下二分查找最大的 n1 (加加速度最小、最平滑)，再检查加加速度上限。
+ *   每段的位移用离散求和的闭式公式计算，J = 距离 / 单位加加速度的总位移，
+ *   整除余数折算为一个极小的速度偏置，最后一个采样恰好停在目标上，没有误差累积。
+ *
+ * 求值 (每个采样):
+ *   位置、速度、加速度为Q46定点数，按前向差分 p += v; v += a; a += j 递推，
+ *   每个采样只有三次64位加法 (Cortex-M3上为ADDS/ADC)，没有乘法、除法与浮点运算；
+ *   只在段切换时更换 j。
+ *
+ * 输出方式与 DAC8568_DDS 相同: DAC8568_Traj_Render 生成流式帧，DAC8568_Traj_Generator 用于乒乓缓冲，
+ * DAC8568_Traj_Step 每次给出一组原生分辨率码值。位置以16位满量程表示，与型号无关。
+ */
+
+#ifndef DAC8568_TRAJ_H
+#define DAC8568_TRAJ_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "DAC8568.h"
+
+#define DAC8568_TRAJ_FRAC 46                   // 位置/速度/加速度/加加速度的小数位数
+#define DAC8568_TRAJ_MAX_SAMPLES (1UL << 20)    // 一次运动的最多采样数 (闭式求和不溢出)
+#define DAC8568_TRAJ_IDLE 7                     // 段号: 静止
+
+    /**
+     * @brief 单个通道的轨迹状态。
+     */
+    typedef struct
+    {
+        int64_t p;              // 位置 (Q46，16位满量程)
+        int64_t v;              // 速度 (Q46/采样)
+        int64_t a;              // 加速度 (Q46/采样²)
+        int64_t j;              // 当前段的加加速度 (Q46/采样³)
+        int64_t jerk;           // 本次运动的加加速度 (带方向)
+        uint32_t len[3];        // 段长 n1, n2, n4
+        uint32_t left;          // 当前段剩余采样数
+        uint16_t hold;          // 静止时的输出 (运动结束后为目标)
+        volatile uint8_t seg;   // 当前段 (0~6)，DAC8568_TRAJ_IDLE 表示静止
+        uint8_t enabled;        // 1: 参与输出
+    } DAC8568_Traj_ChannelTypeDef;
+
+    /**
+     * @brief 轨迹发生器，8个通道共用一个采样时钟。
+     */
+    typedef struct
+    {
+        DAC8568_Traj_ChannelTypeDef ch[8];
+        uint32_t sample_rate;   // 采样率 (每通道，Hz)，用于换算加速度与加加速度上限
+        uint8_t order[8];       // 已启用通道的发送顺序
+        uint8_t active;         // 已启用通道数
+        uint8_t slot;           // 流式渲染时当前组内的位置
+        uint8_t update_cmd;     // 每组最后一帧的命令 (定时LDAC时为 CMD_WRITE_INPUT_REG)
+    } DAC8568_Traj_HandleTypeDef;
+
+    // 函数声明
+    void DAC8568_Traj_Init(DAC8568_Traj_HandleTypeDef *traj, uint32_t sample_rate);
+    void DAC8568_Traj_SetChannel(DAC8568_Traj_HandleTypeDef *traj, uint8_t channel, uint16_t position);
+    HAL_StatusTypeDef DAC8568_Traj_Plan(DAC8568_Traj_HandleTypeDef *traj, uint8_t channel, uint16_t target,
+                                        uint32_t samples, uint32_t accel_max, uint32_t jerk_max);
+    uint8_t DAC8568_Traj_GetMoving(const DAC8568_Traj_HandleTypeDef *traj);
+    void DAC8568_Traj_Step(DAC8568_Traj_HandleTypeDef *traj, uint16_t codes[8]);
+    void DAC8568_Traj_SetLdacStrobe(DAC8568_Traj_HandleTypeDef *traj, uint8_t enable);
+    void DAC8568_Traj_Render(DAC8568_Traj_HandleTypeDef *traj, uint32_t *frames, uint16_t count);
+    void DAC8568_Traj_Generator(void *context, uint32_t *frames, uint16_t count);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* DAC8568_TRAJ_H */
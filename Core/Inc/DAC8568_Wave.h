@@ -0,0 +1,113 @@
+/*
+ * DAC8568 Flash压缩波形回放
+ * 作者: 雪豹
+ */
+/*
+ * 格式:
+ * ----------------------------------------------------------------
+ * 波形由描述符 (DAC8568_WaveTypeDef) 与块数据组成，两者都可以是const，存放在Flash。
+ * 样本为16位满量程数据 (与 DAC8568_DDS 相同)，与 DAC8568_DEVICE 选择的型号无关。
+ * 每通道 samples 个样本，按 block_len 个一组分块 (最后一块可以较短)，块依次连续存放。
+ * 块内按通道号升序，每个包含的通道一条记录:
+ *
+ *   字节0-1  关键帧: 本块第一个样本 (小端)
+ *   字节2    模式:   bit1-0 残差宽度 (0:无残差 1:4位 2:8位 3:16位)
+ *                    bit2   预测器 (0: 前一个样本；1: 线性外推 2x[n-1]-x[n-2])
+ *                    bit7-4 量化移位 s (残差 × 2^s)
+ *   字节3-4  仅线性外推: 初始斜率 x[1]-x[0] (有符号，小端)
+ *   其后     本块其余 n-1 个样本的有符号残差，4位残差低半字节在前，记录按字节对齐
+ *
+ * 还原: x[n] = 预测值 + (残差 << s)，按16位取模计算。每块从关键帧重新开始，
+ * 误差不会跨块累积，也可以按块跳转 (需要 block_offset 表)。
+ * 16位残差、s = 0时为无损；编码器对每块每通道选择满足误差限的最小记录。
+ * 平滑波形多为4位或8位残差，存储量约为原始16位样本的1/4到1/2。
+ *
+ * 回放:
+ *   解码器只保存每通道的当前值与读指针，RAM占用与波形长度无关。
+ *   DAC8568_Wave_Render 生成流式帧 (与 DAC8568_DDS_Render 格式相同)，
+ *   在流式缓冲区的半传输/传输完成时刻逐块展开即可连续输出；
+ *   DAC8568_Wave_Step 每次给出一组原生分辨率码值，用于定时器中断输出。
+ */
+
+#ifndef DAC8568_WAVE_H
+#define DAC8568_WAVE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "DAC8568.h"
+
+// 记录模式字节
+#define DAC8568_WAVE_WIDTH_NONE 0x00   // 无残差 (整块为常数或严格线性)
+#define DAC8568_WAVE_WIDTH_4 0x01      // 4位残差
+#define DAC8568_WAVE_WIDTH_8 0x02      // 8位残差
+#define DAC8568_WAVE_WIDTH_16 0x03     // 16位残差
+#define DAC8568_WAVE_WIDTH_MASK 0x03
+#define DAC8568_WAVE_PREDICT_LINEAR 0x04 // 线性外推预测
+#define DAC8568_WAVE_SHIFT_POS 4
+#define DAC8568_WAVE_MODE(width, predict, shift) \
+    ((uint8_t)((width) | (predict) | ((shift) << DAC8568_WAVE_SHIFT_POS)))
+#define DAC8568_WAVE_RECORD_HEADER 3   // 关键帧2字节 + 模式1字节
+#define DAC8568_WAVE_SLOPE_SIZE 2      // 线性外推记录的初始斜率
+
+    /**
+     * @brief Flash中的压缩波形描述符。
+     */
+    typedef struct
+    {
+        const uint8_t *data;          // 块数据
+        const uint32_t *block_offset; // 每块在 data 中的偏移，仅 DAC8568_Wave_Seek 使用，可为NULL
+        uint32_t samples;             // 每通道样本数
+        uint16_t block_len;           // 每块每通道样本数
+        uint8_t channel_mask;         // 包含的通道 (bit0 = 通道A)
+    } DAC8568_WaveTypeDef;
+
+    /**
+     * @brief 单个通道的解码状态。
+     */
+    typedef struct
+    {
+        const uint8_t *ptr;     // 下一个残差
+        uint16_t value;         // 当前样本
+        int16_t slope;          // 线性外推的斜率 (上一次的差分)
+        uint8_t width;          // 残差宽度 (DAC8568_WAVE_WIDTH_*)
+        uint8_t linear;         // 1: 线性外推预测
+        uint8_t shift;          // 量化移位
+        uint8_t nibble;         // 4位残差: 1表示当前字节的高半字节待读
+    } DAC8568_Wave_ChannelTypeDef;
+
+    /**
+     * @brief 波形解码器。
+     */
+    typedef struct
+    {
+        const DAC8568_WaveTypeDef *wave;
+        DAC8568_Wave_ChannelTypeDef ch[8];
+        const uint8_t *next;    // 下一块的起始地址
+        uint32_t block;         // 当前块号
+        uint16_t index;         // 当前组在块内的序号
+        uint16_t length;        // 当前块的样本数
+        uint8_t order[8];       // 包含的通道的发送顺序
+        uint8_t active;         // 包含的通道数
+        uint8_t slot;           // 流式渲染时当前组内的位置
+        uint8_t loop;           // 1: 结束后从头循环
+        uint8_t done;           // 1: 已播放完毕 (不循环时保持最后的样本)
+        uint8_t update_cmd;     // 每组最后一帧的命令 (定时LDAC时为 CMD_WRITE_INPUT_REG)
+    } DAC8568_Wave_DecoderTypeDef;
+
+    // 函数声明
+    HAL_StatusTypeDef DAC8568_Wave_Init(DAC8568_Wave_DecoderTypeDef *dec, const DAC8568_WaveTypeDef *wave, uint8_t loop);
+    HAL_StatusTypeDef DAC8568_Wave_Seek(DAC8568_Wave_DecoderTypeDef *dec, uint32_t sample);
+    void DAC8568_Wave_Step(DAC8568_Wave_DecoderTypeDef *dec, uint16_t codes[8]);
+    void DAC8568_Wave_SetLdacStrobe(DAC8568_Wave_DecoderTypeDef *dec, uint8_t enable);
+    void DAC8568_Wave_Render(DAC8568_Wave_DecoderTypeDef *dec, uint32_t *frames, uint16_t count);
+    void DAC8568_Wave_Generator(void *context, uint32_t *frames, uint16_t count);
+    uint8_t DAC8568_Wave_IsDone(const DAC8568_Wave_DecoderTypeDef *dec);
+    uint32_t DAC8568_Wave_GetBlockCount(const DAC8568_WaveTypeDef *wave);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* DAC8568_WAVE_H */
@@ -61,6 +61,10 @@ void Error_Handler(void);
 #define LED_GPIO_Port GPIOC
 #define SYNC_Pin GPIO_PIN_4
 #define SYNC_GPIO_Port GPIOA
+#define SYNC2_Pin GPIO_PIN_12
+#define SYNC2_GPIO_Port GPIOB
+#define LDAC_Pin GPIO_PIN_6
+#define LDAC_GPIO_Port GPIOB
 
 /* USER CODE BEGIN Private defines */
 
@@ -2,421 +2,1806 @@
  * DAC8568/DAC8168/DAC8568 驱动程序
  * 作者: 雪豹
  */
-#include "dac8568.h"
+#include "DAC8568.h"
 
-static SPI_HandleTypeDef *hspi_dac; // SPI句柄指针，用于SPI通信
-static GPIO_TypeDef *SYNC_PORT;     // SYNC引脚的GPIO端口指针
-static uint16_t SYNC_PIN;           // SYNC引脚的引脚号
+static DAC8568_HandleTypeDef *dac_handles[DAC8568_MAX_DEVICES]; // 已初始化的设备句柄，用于在SPI回调中查找对应设备
+static uint8_t dac_handle_count;                                  // 已注册的设备数量
+static uint32_t dac_cycles_per_us;                                // 每微秒的HCLK周期数
+static uint32_t dac_reset_cycles;                                 // 软件复位恢复时间 (HCLK周期数)
 
 /**
- * @brief 初始化DAC8568驱动。
- * @param hspi SPI外设句柄指针。
- * @param sync_port SYNC引脚的GPIO端口。
- * @param sync_pin SYNC引脚的引脚号。
- * @note 此函数会保存SPI和SYNC引脚的配置，并将SYNC引脚初始化为高电平。
- *       默认执行软件复位，可选启用内部参考电压。
+ * @brief 初始化时序服务: 使能DWT周期计数器并按当前HCLK换算微秒。
+ * @note 由 DAC8568_Init 调用；修改系统时钟后需重新调用。不清零CYCCNT，不影响其它使用者。
  */
-void DAC8568_Init(SPI_HandleTypeDef *hspi, GPIO_TypeDef *sync_port, uint16_t sync_pin)
+void DAC8568_Time_Init(void)
 {
-    hspi_dac = hspi;       // 保存SPI句柄
-    SYNC_PORT = sync_port; // 保存SYNC引脚的端口
-    SYNC_PIN = sync_pin;   // 保存SYNC引脚的引脚号
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0)
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; // 先使能跟踪模块，DWT寄存器才可写
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    dac_cycles_per_us = HAL_RCC_GetHCLKFreq() / 1000000U;
+    dac_reset_cycles = DAC8568_UsToCycles(DAC8568_RESET_RECOVERY_US);
+}
 
-    // 初始化SYNC引脚为高电平(空闲状态)
-    HAL_GPIO_WritePin(SYNC_PORT, SYNC_PIN, GPIO_PIN_SET);
+/**
+ * @brief 微秒换算为HCLK周期数。
+ * @param us 微秒。
+ * @retval 周期数 (72MHz时最大约59秒)。
+ */
+uint32_t DAC8568_UsToCycles(uint32_t us)
+{
+    return us * dac_cycles_per_us;
+}
 
-    // 可选: 执行软件复位(参考数据手册第39页表6)
-    DAC8568_SoftwareReset(); // 执行软件复位，确保DAC上电后处于已知的默认状态
+/**
+ * @brief 判断时刻 deadline 是否仍未到达。
+ * @param deadline 目标时刻 (DWT->CYCCNT)。
+ * @param span 设定 deadline 时的等待长度，用于识别已过期很久、CYCCNT已回绕的旧时刻。
+ * @retval 1 仍需等待，0 已到达。
+ */
+static inline uint8_t DAC8568_Pending(uint32_t deadline, uint32_t span)
+{
+    return (uint32_t)(deadline - DWT->CYCCNT) - 1U < span; // 剩余周期数在 [1, span] 内
+}
 
-    // 可选: 启用内部参考(参考数据手册第44页表7)
-    // DAC8568_EnableStaticInternalRef(); // 如果需要使用内部参考电压，取消此行注释
+/**
+ * @brief 忙等待到时刻 deadline。
+ */
+static void DAC8568_WaitUntil(uint32_t deadline, uint32_t span)
+{
+    while (DAC8568_Pending(deadline, span))
+    {
+        __NOP();
+    }
 }
 
 /**
- * @brief 向DAC指定通道的输入寄存器写入数据。
- * @param channel 目标DAC通道 (CHANNEL_A 到 CHANNEL_H, 或 BROADCAST)。
- * @param data 要写入的16位数据。
- * @note 此操作仅更新输入寄存器，不会立即更新DAC的模拟输出。
- *       参考数据手册第35页表4。
+ * @brief 微秒级延时 (DWT周期计数，不依赖SysTick)。
+ * @param us 延时微秒数。
+ */
+void DAC8568_DelayUs(uint32_t us)
+{
+    uint32_t span = DAC8568_UsToCycles(us);
+    DAC8568_WaitUntil(DWT->CYCCNT + span, span);
+}
+
+/**
+ * @brief 获取设备的发送权：等待本设备上一次传输完成，并等待同一SPI总线上的其它设备释放总线。
+ * @param hdac DAC8568设备句柄。
+ * @retval 1 可以发送；0 设备被流式输出引擎占用，应丢弃本次发送。
  */
-void DAC8568_Write(uint8_t channel, uint16_t data)
+static uint8_t DAC8568_Acquire(DAC8568_HandleTypeDef *hdac)
 {
-    uint8_t txData[4]; // 定义SPI传输的4字节数据缓冲区
+    if (hdac->streaming)
+    {
+        return 0; // SPI与DMA由流式输出引擎占用
+    }
 
-    // 32位帧格式:
-    // [31:28] 前缀位(0000) - 固定为0
-    // [27:24] 命令位(CMD_WRITE_INPUT_REG = 0000) - 写入输入寄存器命令
-    // [23:20] 地址位(channel) - 选择目标DAC通道
-    // [19:4]  数据位(data) - 16位DAC数据
-    // [3:0]   特征位(0000) - 此命令中不使用，固定为0
+    DAC8568_WaitForTransfer(hdac); // 等待本设备上一帧发送完成 (SYNC已拉高)
+    while (hdac->hspi->State != HAL_SPI_STATE_READY)
+    {
+        // 同一SPI总线上的其它设备正在传输
+    }
+    return 1;
+}
 
-    // 第一个字节 (DB31-DB24): 包含前缀位和命令位
-    // 7-4位 (DB31-DB28): 前缀位 (0000)
-    // 3-0位 (DB27-DB24): 命令位 (CMD_WRITE_INPUT_REG = 0000)
-    txData[0] = 0b00000000 | (CMD_WRITE_INPUT_REG & 0b00001111); // 构造第一个字节
+/**
+ * @brief 一次传输 (单帧或连发) 结束时的处理。
+ * @param hdac DAC8568设备句柄。
+ * @param status 传输结果。
+ * @note 失败时部分帧未发出，影子寄存器不再可信；异步传输在此调用用户回调。
+ */
+static void DAC8568_Complete(DAC8568_HandleTypeDef *hdac, HAL_StatusTypeDef status)
+{
+    if (status != HAL_OK)
+    {
+        hdac->shadow.valid = 0;
+    }
+    if (hdac->tx_async)
+    {
+        hdac->tx_async = 0;
+        hdac->last_status = status;
+        if (hdac->callback != NULL)
+        {
+            hdac->callback(hdac, status);
+        }
+    }
+}
 
-    // 第二个字节 (DB23-DB16): 包含地址位和数据位的高4位
-    // 7-4位 (DB23-DB20): 地址位 (通道选择)
-    // 3-0位 (DB19-DB16): 16位数据的最高4位 (D15-D12)
-    txData[1] = ((channel & 0b00001111) << 4) | ((data >> 12) & 0b00001111); // 构造第二个字节
+#if DAC8568_TRACE
+/**
+ * @brief 事务开始: 记录时刻与帧，在拉低SYNC之前调用。
+ * @param hdac DAC8568设备句柄。
+ * @param wire 线上顺序帧。
+ */
+static inline void DAC8568_TraceBegin(DAC8568_HandleTypeDef *hdac, uint32_t wire)
+{
+    hdac->trace.wire = wire;
+    hdac->trace.start = DWT->CYCCNT;
+}
 
-    // 第三个字节 (DB15-DB8): 包含数据位的中间8位
-    // 7-0位 (DB15-DB8): 16位数据的中间8位 (D11-D4)
-    txData[2] = (data >> 4) & 0xFF; // 构造第三个字节
+/**
+ * @brief 事务结束: 在拉高SYNC之后调用，写入环形缓冲区并更新该命令的统计。
+ * @param hdac DAC8568设备句柄。
+ * @note 只有加法、比较与存储，没有除法；平均值在 DAC8568_Trace_GetStats 中计算。
+ */
+static void DAC8568_TraceEnd(DAC8568_HandleTypeDef *hdac)
+{
+    DAC8568_TraceTypeDef *t = &hdac->trace;
+    uint32_t cycles = DWT->CYCCNT - t->start; // 无符号减法，CYCCNT回绕时结果仍正确
+    uint32_t frame = hdac->spi16 ? DAC8568_FrameToHalfWords(t->wire) : __REV(t->wire); // 两种转换都是自身的逆
+    uint8_t cmd = (frame >> 24) & 0x0F;
+    uint32_t head = t->head;
+
+    DAC8568_TraceRecordTypeDef *r = &t->ring[head & (DAC8568_TRACE_SIZE - 1)];
+    r->start = t->start;
+    r->cycles = cycles;
+    r->cmd = cmd;
+    r->addr = (frame >> 20) & 0x0F;
+    t->head = head + 1U; // 记录写完后再发布
+
+    t->count[cmd]++;
+    t->sum[cmd] += cycles;
+    if (cycles < t->min[cmd])
+    {
+        t->min[cmd] = cycles;
+    }
+    if (cycles > t->max[cmd])
+    {
+        t->max[cmd] = cycles;
+        t->max_start[cmd] = t->start;
+    }
+}
 
-    // 第四个字节 (DB7-DB0): 包含数据位的低4位和特征位
-    // 7-4位 (DB7-DB4): 16位数据的最低4位 (D3-D0)
-    // 3-0位 (DB3-DB0): 特征位 (0000)
-    txData[3] = ((data & 0b00001111) << 4) | 0b00000000; // 构造第四个字节
+#define DAC8568_TRACE_BEGIN(hdac, wire) DAC8568_TraceBegin(hdac, wire)
+#define DAC8568_TRACE_END(hdac) DAC8568_TraceEnd(hdac)
+#else
+#define DAC8568_TRACE_BEGIN(hdac, wire) ((void)0)
+#define DAC8568_TRACE_END(hdac) ((void)0)
+#endif
 
-    // 执行SPI传输
-    HAL_GPIO_WritePin(SYNC_PORT, SYNC_PIN, GPIO_PIN_RESET); // 拉低SYNC引脚，片选DAC，开始传输
-    HAL_SPI_Transmit(hspi_dac, txData, 4, HAL_MAX_DELAY);   // 通过SPI发送4个字节的数据
-    HAL_GPIO_WritePin(SYNC_PORT, SYNC_PIN, GPIO_PIN_SET);   // 拉高SYNC引脚，取消片选DAC，结束传输
+#if DAC8568_USE_DMA
+/**
+ * @brief 拉低SYNC并以DMA方式启动一帧的发送。
+ * @param hdac DAC8568设备句柄。
+ * @param wire 指向线上顺序帧的指针，传输完成前必须保持有效。
+ * @retval HAL_SPI_Transmit_DMA 的返回值；总线已被同一总线上的其它设备占用时为 HAL_BUSY (SYNC保持高电平)。
+ * @note 总线检查、拉低SYNC与启动DMA在短暂关中断的区间内完成，不会在其它设备的帧移位时拉低本设备的SYNC。
+ *       启动失败时放弃剩余的连发帧并释放设备，队列帧保留在队列中。
+ */
+static HAL_StatusTypeDef DAC8568_StartFrameDMA(DAC8568_HandleTypeDef *hdac, const uint32_t *wire)
+{
+    HAL_StatusTypeDef status = HAL_BUSY;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq(); // 检查总线到HAL占用总线之间，同一总线上其它设备的传输完成中断不能启动它的队列
+    if (hdac->hspi->State == HAL_SPI_STATE_READY)
+    {
+        DAC8568_TRACE_BEGIN(hdac, *wire); // 在传输完成或错误回调中结束
+        HAL_GPIO_WritePin(hdac->sync_port, hdac->sync_pin, GPIO_PIN_RESET); // 拉低SYNC，开始传输
+        status = HAL_SPI_Transmit_DMA(hdac->hspi, (uint8_t *)wire, hdac->spi16 ? 2 : 4); // 16位模式按半字计数
+        if (status != HAL_OK)
+        {
+            HAL_GPIO_WritePin(hdac->sync_port, hdac->sync_pin, GPIO_PIN_SET);
+        }
+    }
+    __set_PRIMASK(primask);
+    if (status != HAL_OK)
+    {
+        // 启动失败或总线已被占用 (SYNC未拉低): 清除忙标志，放弃剩余帧
+        uint8_t queued = hdac->tx_queued;
+        hdac->tx_remaining = 0;
+        hdac->tx_queued = 0; // 队列帧保留在队列中，下一次入队或传输完成时重试
+        hdac->busy = 0;
+        if (!queued)
+        {
+            DAC8568_Complete(hdac, status);
+        }
+    }
+    return status;
 }
 
 /**
- * @brief 更新DAC指定通道的输出。
- * @param channel 目标DAC通道 (CHANNEL_A 到 CHANNEL_H, 或 BROADCAST)。
- * @note 此操作会将对应通道输入寄存器中的值加载到DAC寄存器，从而更新模拟输出。
- *       参考数据手册第36页表4。
+ * @brief 以DMA方式发送命令队列中最早的一帧。
+ * @param hdac DAC8568设备句柄，调用前设备空闲且SPI总线处于READY状态。
+ * @note 帧在传输完成回调中才出队，传输期间生产者不会覆盖该位置。
  */
-void DAC8568_Update(uint8_t channel)
+static void DAC8568_QueueStart(DAC8568_HandleTypeDef *hdac)
 {
-    uint8_t txData[4]; // 定义SPI传输的4字节数据缓冲区
+    hdac->tx_remaining = 0;
+    hdac->tx_queued = 1;
+    hdac->busy = 1;
+    DAC8568_StartFrameDMA(hdac, &hdac->queue[hdac->queue_tail & (DAC8568_QUEUE_SIZE - 1)]);
+}
 
-    // 32位帧格式:
-    // [31:28] 前缀位(0000)
-    // [27:24] 命令位(CMD_UPDATE_DAC_REG = 0001) - 更新DAC寄存器命令
-    // [23:20] 地址位(channel) - 选择目标DAC通道
-    // [19:4]  数据位(均为0) - 此命令中数据位不使用
-    // [3:0]   特征位(0000) - 此命令中不使用
+/**
+ * @brief 总线空闲时，启动该总线上第一个有待发帧的设备的命令队列。
+ * @param hspi SPI句柄。
+ */
+static void DAC8568_QueueService(SPI_HandleTypeDef *hspi)
+{
+    for (uint8_t i = 0; i < dac_handle_count; i++)
+    {
+        DAC8568_HandleTypeDef *hdac = dac_handles[i];
+        if (hspi->State != HAL_SPI_STATE_READY)
+        {
+            return; // 总线已被占用
+        }
+        if (hdac->hspi == hspi && !hdac->busy && !hdac->streaming && hdac->queue_head != hdac->queue_tail)
+        {
+            DAC8568_QueueStart(hdac);
+        }
+    }
+}
+#endif
 
-    // 第一个字节 (DB31-DB24): 前缀位 + 命令位
-    txData[0] = 0b00000000 | (CMD_UPDATE_DAC_REG & 0b00001111);
+#if DAC8568_BACKEND == DAC8568_BACKEND_REG
+/**
+ * @brief 寄存器级阻塞发送：直接写DR并轮询状态标志，不经过HAL。
+ * @param hdac DAC8568设备句柄。
+ * @param wire 线上顺序帧数组。
+ * @param count 帧数。
+ * @note 每帧: BSRR拉低SYNC -> 4次 (8位) 或2次 (16位) (等待TXE, 写DR) -> 等待TXE且BSY清零 -> BSRR拉高SYNC。
+ *       必须等待BSY清零后再拉高SYNC，否则最后一个字节尚未移出，DAC会丢弃该帧。
+ *       全双工模式下接收端会产生溢出 (OVR)，结束时读DR、SR清除，保证后续HAL调用正常。
+ *       寄存器经CMSIS的 READ_REG/WRITE_REG/SET_BIT 访问，主机替身据此模拟SPI与GPIO外设。
+ * @retval HAL_OK (寄存器级轮询不设超时)。
+ */
+static HAL_StatusTypeDef DAC8568_TransmitPolled(DAC8568_HandleTypeDef *hdac, const uint32_t *wire, uint16_t count)
+{
+    SPI_TypeDef *spi = hdac->hspi->Instance;
+    GPIO_TypeDef *port = hdac->sync_port;
+    uint32_t pin = hdac->sync_pin;
 
-    // 第二个字节 (DB23-DB16): 地址位 + 数据高4位(0)
-    txData[1] = ((channel & 0b00001111) << 4) | 0b00000000;
+    if ((READ_REG(spi->CR1) & SPI_CR1_SPE) == 0)
+    {
+        SET_BIT(spi->CR1, SPI_CR1_SPE); // HAL在首次传输时才使能SPI
+    }
 
-    // 第三个字节 (DB15-DB8): 数据中间8位(0)
-    txData[2] = 0;
-    // 第四个字节 (DB7-DB0): 数据低4位(0) + 特征位(0)
-    txData[3] = 0;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        DAC8568_TRACE_BEGIN(hdac, wire[i]);
+        WRITE_REG(port->BSRR, pin << 16); // 拉低SYNC
+        if (hdac->spi16)
+        {
+            const uint16_t *halves = (const uint16_t *)&wire[i];
+            for (uint8_t k = 0; k < 2; k++)
+            {
+                while ((READ_REG(spi->SR) & SPI_SR_TXE) == 0)
+                {
+                }
+                WRITE_REG(spi->DR, halves[k]);
+            }
+        }
+        else
+        {
+            const uint8_t *bytes = (const uint8_t *)&wire[i];
+            for (uint8_t k = 0; k < 4; k++)
+            {
+                while ((READ_REG(spi->SR) & SPI_SR_TXE) == 0)
+                {
+                }
+                WRITE_REG(spi->DR, bytes[k]);
+            }
+        }
+        while ((READ_REG(spi->SR) & SPI_SR_TXE) == 0)
+        {
+        }
+        while (READ_REG(spi->SR) & SPI_SR_BSY)
+        {
+        }
+        WRITE_REG(port->BSRR, pin); // 拉高SYNC
+        DAC8568_TRACE_END(hdac);
+    }
 
-    // 执行SPI传输
-    HAL_GPIO_WritePin(SYNC_PORT, SYNC_PIN, GPIO_PIN_RESET);
-    HAL_SPI_Transmit(hspi_dac, txData, 4, HAL_MAX_DELAY);
-    HAL_GPIO_WritePin(SYNC_PORT, SYNC_PIN, GPIO_PIN_SET);
+    (void)READ_REG(spi->DR); // 清除OVR标志
+    (void)READ_REG(spi->SR);
+    return HAL_OK;
+}
+#else
+/**
+ * @brief HAL阻塞发送：逐帧调用 HAL_SPI_Transmit。
+ * @param hdac DAC8568设备句柄。
+ * @param wire 线上顺序帧数组。
+ * @param count 帧数。
+ * @retval HAL_OK，或第一个失败帧的 HAL_SPI_Transmit 返回值 (其后的帧不再发送)。
+ */
+static HAL_StatusTypeDef DAC8568_TransmitPolled(DAC8568_HandleTypeDef *hdac, const uint32_t *wire, uint16_t count)
+{
+    uint16_t size = hdac->spi16 ? 2 : 4; // HAL按数据帧计数: 2个半字或4个字节
+    for (uint16_t i = 0; i < count; i++)
+    {
+        DAC8568_TRACE_BEGIN(hdac, wire[i]);
+        HAL_GPIO_WritePin(hdac->sync_port, hdac->sync_pin, GPIO_PIN_RESET); // 拉低SYNC引脚，片选DAC，开始传输
+        HAL_StatusTypeDef status = HAL_SPI_Transmit(hdac->hspi, (uint8_t *)&wire[i], size, DAC8568_SPI_TIMEOUT); // 通过SPI发送32位帧
+        HAL_GPIO_WritePin(hdac->sync_port, hdac->sync_pin, GPIO_PIN_SET); // 拉高SYNC引脚，取消片选DAC，结束传输
+        DAC8568_TRACE_END(hdac); // 超时的帧同样记录，即要找的延迟尖峰
+        if (status != HAL_OK)
+        {
+            return status;
+        }
+    }
+    return HAL_OK;
 }
+#endif
 
 /**
- * @brief 向DAC指定通道的输入寄存器写入数据并立即更新其模拟输出。
- * @param channel 目标DAC通道 (CHANNEL_A 到 CHANNEL_H)。
- * @param data 要写入的16位数据。
- * @note 参考数据手册第37页表4。
+ * @brief 连续发送多个线上顺序帧，每帧独立拉低/拉高一次SYNC。
+ * @param hdac DAC8568设备句柄。
+ * @param wire 线上顺序帧数组，DMA模式下在 DAC8568_IsBusy 返回0之前必须保持有效。
+ * @param count 帧数。
+ * @note DMA模式下只启动第一帧即返回，后续帧在传输完成回调中依次启动 (中断链式发送)，
+ *       帧与帧之间只有拉高/拉低SYNC的间隔，不经过主循环。
+ *       阻塞模式下由 DAC8568_BACKEND 选择的轮询后端逐帧发送。
+ *       调用前需已通过 DAC8568_Acquire 获取发送权。
+ * @retval DMA模式为启动结果，阻塞模式为发送结果。结束时经 DAC8568_Complete 通知异步回调。
  */
-void DAC8568_WriteAndUpdate(uint8_t channel, uint16_t data)
+static HAL_StatusTypeDef DAC8568_TransmitBurst(DAC8568_HandleTypeDef *hdac, const uint32_t *wire, uint16_t count)
 {
-    uint8_t txData[4]; // 定义SPI传输的4字节数据缓冲区
+    if (count == 0)
+    {
+        DAC8568_Complete(hdac, HAL_OK); // 全部帧均为冗余帧
+        return HAL_OK;
+    }
 
-    // 32位帧格式 (参考数据手册第37页表4):
-    // [31:28] 前缀位(0000)
-    // [27:24] 命令位(CMD_WRITE_INPUT_UPDATE_ONE = 0011) - 写入输入寄存器并更新单个DAC命令
-    // [23:20] 地址位(channel) - 选择目标DAC通道
-    // [19:4]  数据位(data) - 16位DAC数据
-    // [3:0]   特征位(0000) - 此命令中不使用
+#if DAC8568_USE_DMA
+    if (hdac->hspi->hdmatx != NULL)
+    {
+        hdac->tx_next = wire + 1;
+        hdac->tx_remaining = count - 1;
+        hdac->tx_queued = 0;
+        hdac->busy = 1;
+        return DAC8568_StartFrameDMA(hdac, wire); // SYNC将在传输完成回调中拉高，剩余帧在回调中继续发送
+    }
+#endif
 
-    // 第一个字节 (DB31-DB24): 前缀位 + 命令位
-    txData[0] = 0b00000000 | (CMD_WRITE_INPUT_UPDATE_ONE & 0b00001111);
+    HAL_StatusTypeDef status = DAC8568_TransmitPolled(hdac, wire, count);
+    DAC8568_Complete(hdac, status);
+    return status;
+}
 
-    // 第二个字节 (DB23-DB16): 地址位 + 数据高4位
-    txData[1] = ((channel & 0b00001111) << 4) | ((data >> 12) & 0b00001111);
+/**
+ * @brief 发送一个线上顺序的32位帧 (拉低SYNC -> 发送4字节/2个半字 -> 拉高SYNC)。
+ * @param hdac DAC8568设备句柄。
+ * @param wire 按发送顺序存放的帧 (由 DAC8568_ToWire 转换得到)。
+ * @note 调用前需已通过 DAC8568_Acquire 获取发送权。
+ *       若SPI句柄已关联DMA (hspi->hdmatx != NULL) 且 DAC8568_USE_DMA 为1，
+ *       则帧数据被复制到句柄内的缓冲区后以DMA方式发送，函数立即返回，
+ *       SYNC在传输完成回调 DAC8568_TxCpltCallback 中拉高；
+ *       否则使用阻塞方式 HAL_SPI_Transmit 发送。
+ */
+static void DAC8568_TransmitWire(DAC8568_HandleTypeDef *hdac, uint32_t wire)
+{
+    hdac->tx_buf[0] = wire; // DMA传输期间缓冲区必须保持有效，不能使用局部变量
+    DAC8568_TransmitBurst(hdac, hdac->tx_buf, 1);
+}
 
-    // 第三个字节 (DB15-DB8): 数据中间8位
-    txData[2] = (data >> 4) & 0xFF;
+/**
+ * @brief 按设备的SPI数据帧宽度将数值形式的帧转换为发送顺序。
+ * @param hdac DAC8568设备句柄。
+ * @param frame 数值形式的帧。
+ * @retval 8位模式为字节反序 (REV)，16位模式为半字交换 (ROR 16)。
+ */
+static inline uint32_t DAC8568_ToWire(const DAC8568_HandleTypeDef *hdac, uint32_t frame)
+{
+    return hdac->spi16 ? DAC8568_FrameToHalfWords(frame) : DAC8568_FrameToWire(frame);
+}
 
-    // 第四个字节 (DB7-DB0): 数据低4位 + 特征位
-    txData[3] = ((data & 0b00001111) << 4) | 0b00000000;
+/**
+ * @brief 把影子寄存器恢复为上电默认值 (参考数据手册第39页表6)。
+ * @param shadow 影子寄存器。
+ */
+static void DAC8568_ShadowReset(DAC8568_ShadowTypeDef *shadow)
+{
+    for (uint8_t ch = 0; ch < 8; ch++)
+    {
+        shadow->input_reg[ch] = DAC8568_RESET_CODE;
+        shadow->dac_reg[ch] = DAC8568_RESET_CODE;
+        shadow->power_mode[ch] = POWER_UP;
+    }
+    shadow->ldac_mask = 0;
+    shadow->clear_code = CLEAR_CODE_ZERO_SCALE;
+    shadow->ref_static = 0;
+    shadow->ref_flex = 0;
+    shadow->valid = 1;
+}
 
-    // 执行SPI传输 (参考数据手册第7-8页时序要求)
-    HAL_GPIO_WritePin(SYNC_PORT, SYNC_PIN, GPIO_PIN_RESET);
-    HAL_SPI_Transmit(hspi_dac, txData, 4, HAL_MAX_DELAY);
-    HAL_GPIO_WritePin(SYNC_PORT, SYNC_PIN, GPIO_PIN_SET);
+/**
+ * @brief 写入一个16位影子寄存器。
+ * @retval 1 值发生变化，0 与原值相同。
+ */
+static inline uint8_t DAC8568_ShadowSet16(uint16_t *reg, uint16_t value)
+{
+    uint8_t changed = (*reg != value);
+    *reg = value;
+    return changed;
 }
 
 /**
- * @brief 将数据数组中的值分别写入所有8个DAC通道的输入寄存器。
- * @param data_array 包含8个uint16_t类型数据的数组指针，分别对应通道A到H。
- * @note 此函数通过循环调用 DAC8568_Write 实现。
- *       参考数据手册第36页表4。
+ * @brief 按芯片的命令语义把一帧作用到影子寄存器上。
+ * @param shadow 影子寄存器。
+ * @param frame 数值形式的帧 (DB31位于最高位)。
+ * @retval 1 该帧会改变芯片状态 (或无法判断)，0 该帧是冗余的。
+ * @note 参考数据手册第35-47页。LDAC寄存器中对应位为1的通道在写入输入寄存器时同时更新DAC寄存器。
+ *       软件复位和未知命令总是返回1。
  */
-void DAC8568_WriteAllChannels(uint16_t *data_array) // 参数为包含8个通道数据的数组指针
+static uint8_t DAC8568_ShadowApply(DAC8568_ShadowTypeDef *shadow, uint32_t frame)
 {
-    for (uint8_t ch = 0; ch < 8; ch++) // 遍历0到7，代表通道A到H
+    uint8_t cmd = (frame >> 24) & 0x0F;
+    uint8_t addr = (frame >> 20) & 0x0F;
+    uint16_t data = (uint16_t)(frame >> 4);
+    uint8_t changed = 0;
+
+    switch (cmd)
+    {
+    case CMD_WRITE_INPUT_REG:
+    case CMD_UPDATE_DAC_REG:
+    case CMD_WRITE_INPUT_UPDATE_ONE:
+    case CMD_WRITE_INPUT_UPDATE_ALL:
     {
-        DAC8568_Write(ch, data_array[ch]); // 为当前通道 ch 写入数组中对应的数据
+        if (addr > CHANNEL_H && addr != BROADCAST)
+        {
+            return 0; // 无效地址，芯片忽略该帧
+        }
+        uint8_t first = (addr == BROADCAST) ? 0 : addr;
+        uint8_t last = (addr == BROADCAST) ? 7 : addr;
+        for (uint8_t ch = first; ch <= last; ch++)
+        {
+            if (cmd != CMD_UPDATE_DAC_REG)
+            {
+                changed |= DAC8568_ShadowSet16(&shadow->input_reg[ch], data);
+            }
+            if (cmd == CMD_UPDATE_DAC_REG || cmd == CMD_WRITE_INPUT_UPDATE_ONE || (shadow->ldac_mask & (1U << ch)))
+            {
+                changed |= DAC8568_ShadowSet16(&shadow->dac_reg[ch], shadow->input_reg[ch]);
+            }
+        }
+        if (cmd == CMD_WRITE_INPUT_UPDATE_ALL)
+        {
+            for (uint8_t ch = 0; ch < 8; ch++)
+            {
+                changed |= DAC8568_ShadowSet16(&shadow->dac_reg[ch], shadow->input_reg[ch]);
+            }
+        }
+        break;
+    }
+
+    case CMD_POWER_DOWN: // DB9-DB8: 电源模式，DB7-DB0: 通道选择
+        for (uint8_t ch = 0; ch < 8; ch++)
+        {
+            uint8_t mode = (frame >> 8) & 0x03;
+            if ((frame & (1U << ch)) && shadow->power_mode[ch] != mode)
+            {
+                shadow->power_mode[ch] = mode;
+                changed = 1;
+            }
+        }
+        break;
+
+    case CMD_CLEAR_CODE_REG: // DB1-DB0
+        changed = (shadow->clear_code != (frame & 0x03));
+        shadow->clear_code = frame & 0x03;
+        break;
+
+    case CMD_LDAC_REG: // DB7-DB0
+        changed = (shadow->ldac_mask != (frame & 0xFF));
+        shadow->ldac_mask = frame & 0xFF;
+        break;
+
+    case CMD_INTERNAL_REF:
+        if (addr == 0) // 静态模式: DB0
+        {
+            changed = (shadow->ref_static != (frame & 0x01));
+            shadow->ref_static = frame & 0x01;
+        }
+        else // 灵活模式
+        {
+            changed = DAC8568_ShadowSet16(&shadow->ref_flex, data);
+        }
+        break;
+
+    case CMD_SOFTWARE_RESET:
+        DAC8568_ShadowReset(shadow);
+        changed = 1;
+        break;
+
+    default:
+        changed = 1;
+        break;
     }
+    return changed;
 }
 
 /**
- * @brief 更新所有DAC通道的模拟输出。
- * @note 此函数使用CMD_UPDATE_DAC_REG命令和BROADCAST地址。
- *       参考数据手册第36页表4。
+ * @brief 更新影子寄存器并判断一帧是否需要发送。
+ * @param hdac DAC8568设备句柄。
+ * @param frame 数值形式的帧。
+ * @retval 1 需要发送，0 冗余帧已跳过 (计入 frames_skipped)。
+ */
+static uint8_t DAC8568_ShadowFilter(DAC8568_HandleTypeDef *hdac, uint32_t frame)
+{
+    if (DAC8568_ShadowApply(&hdac->shadow, frame) || !hdac->shadow.valid || !hdac->skip_redundant)
+    {
+        return 1;
+    }
+    hdac->frames_skipped++;
+    return 0;
+}
+
+/**
+ * @brief 计算一帧会更新哪些通道的DAC寄存器 (模拟输出)。
+ * @param shadow 影子寄存器 (提供LDAC寄存器)。
+ * @param frame 数值形式的帧。
+ * @retval 通道掩码，bit0对应通道A。
  */
-void DAC8568_UpdateAllChannels(void)
+static uint8_t DAC8568_UpdateMask(const DAC8568_ShadowTypeDef *shadow, uint32_t frame)
 {
-    uint8_t txData[4]; // 定义SPI传输的4字节数据缓冲区
+    uint8_t cmd = (frame >> 24) & 0x0F;
+    uint8_t addr = (frame >> 20) & 0x0F;
+    uint8_t sel = (addr == BROADCAST) ? 0xFF : (addr <= CHANNEL_H) ? (uint8_t)(1U << addr) : 0;
+
+    switch (cmd)
+    {
+    case CMD_UPDATE_DAC_REG:
+    case CMD_WRITE_INPUT_UPDATE_ONE:
+        return sel;
+    case CMD_WRITE_INPUT_UPDATE_ALL:
+        return 0xFF;
+    case CMD_WRITE_INPUT_REG:
+        return sel & shadow->ldac_mask; // LDAC寄存器对应位为1的通道写入即更新
+    default:
+        return 0;
+    }
+}
 
-    // 32位帧格式:
-    // [31:28] 前缀位(0000)
-    // [27:24] 命令位(CMD_UPDATE_DAC_REG = 0001)
-    // [23:20] 地址位(BROADCAST = 1111) - 广播地址，操作所有通道
-    // [19:4]  数据位(均为0)
-    // [3:0]   特征位(0000)
+/**
+ * @brief 判断现在能否发送更新 mask 中通道的帧 (不等待)。
+ * @param hdac DAC8568设备句柄。
+ * @param mask 将被更新的通道。
+ * @retval 1 复位恢复已结束且各通道的最小间隔均已满足，0 需要等待。
+ */
+static uint8_t DAC8568_TimingReady(DAC8568_HandleTypeDef *hdac, uint8_t mask)
+{
+    if (hdac->recovering)
+    {
+        if (DAC8568_Pending(hdac->ready_at, dac_reset_cycles))
+        {
+            return 0;
+        }
+        hdac->recovering = 0;
+    }
+    mask &= hdac->throttle_mask;
+    for (uint8_t ch = 0; mask != 0; ch++, mask >>= 1)
+    {
+        if ((mask & 1U) && DAC8568_Pending(hdac->not_before[ch], hdac->min_interval[ch]))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
 
-    // 第一个字节 (DB31-DB24): 前缀位 + 命令位
-    txData[0] = 0b00000000 | (CMD_UPDATE_DAC_REG & 0b00001111);
+/**
+ * @brief 等待复位恢复结束以及 mask 中各通道的最小更新间隔。
+ * @param hdac DAC8568设备句柄。
+ * @param mask 将被更新的通道，0表示只等待复位恢复。
+ * @note 未设置间隔且不在复位恢复期时只有两次判断，不读取CYCCNT。
+ */
+static void DAC8568_Throttle(DAC8568_HandleTypeDef *hdac, uint8_t mask)
+{
+    if (hdac->recovering)
+    {
+        DAC8568_WaitUntil(hdac->ready_at, dac_reset_cycles);
+        hdac->recovering = 0;
+    }
+    mask &= hdac->throttle_mask;
+    for (uint8_t ch = 0; mask != 0; ch++, mask >>= 1)
+    {
+        if (mask & 1U)
+        {
+            DAC8568_WaitUntil(hdac->not_before[ch], hdac->min_interval[ch]);
+        }
+    }
+}
 
-    // 第二个字节 (DB23-DB16): 广播地址 + 数据高4位(0)
-    txData[1] = (BROADCAST << 4) | 0b00000000; // 使用 BROADCAST 地址
+/**
+ * @brief 记录 mask 中各通道的更新时刻，计算下一次允许更新的时刻。
+ * @note 以帧开始发送的时刻计，与实际更新 (SYNC上升沿) 相差一个帧时间，对前后两次更新相同。
+ */
+static void DAC8568_Stamp(DAC8568_HandleTypeDef *hdac, uint8_t mask)
+{
+    mask &= hdac->throttle_mask;
+    if (mask == 0)
+    {
+        return;
+    }
+    uint32_t now = DWT->CYCCNT;
+    for (uint8_t ch = 0; mask != 0; ch++, mask >>= 1)
+    {
+        if (mask & 1U)
+        {
+            hdac->not_before[ch] = now + hdac->min_interval[ch];
+        }
+    }
+}
 
-    // 第三个字节 (DB15-DB8): 数据中间8位(0)
-    txData[2] = 0;
-    // 第四个字节 (DB7-DB0): 数据低4位(0) + 特征位(0)
-    txData[3] = 0;
+/**
+ * @brief 发送一个32位帧。
+ * @param hdac DAC8568设备句柄。
+ * @param frame 由 DAC8568_EncodeFrame 编码的帧 (数值形式，DB31位于最高位)。
+ * @note 不改变芯片状态的帧在影子寄存器有效且 skip_redundant 为1时被跳过。
+ *       发送前等待复位恢复和被更新通道的最小间隔。
+ *       流式输出期间调用将直接丢弃该帧，影子寄存器不变。
+ */
+static inline void DAC8568_TransmitFrame(DAC8568_HandleTypeDef *hdac, uint32_t frame)
+{
+    if (!DAC8568_Acquire(hdac))
+    {
+        return; // 先获取发送权再更新影子寄存器，被丢弃的帧不能记入芯片状态
+    }
+    if (DAC8568_ShadowFilter(hdac, frame))
+    {
+        uint8_t mask = DAC8568_UpdateMask(&hdac->shadow, frame);
+        DAC8568_Throttle(hdac, mask);
+        DAC8568_TransmitWire(hdac, DAC8568_ToWire(hdac, frame));
+        DAC8568_Stamp(hdac, mask);
+    }
+}
 
-    // 执行SPI传输
-    HAL_GPIO_WritePin(SYNC_PORT, SYNC_PIN, GPIO_PIN_RESET);
-    HAL_SPI_Transmit(hspi_dac, txData, 4, HAL_MAX_DELAY);
-    HAL_GPIO_WritePin(SYNC_PORT, SYNC_PIN, GPIO_PIN_SET);
+/**
+ * @brief 把8个通道的数据编码到句柄的发送缓冲区，跳过冗余帧。
+ * @param hdac DAC8568设备句柄，调用前需已获取发送权 (tx_buf 空闲)。
+ * @param data_array 通道A到H的码值 (原生分辨率)。
+ * @param last_cmd 通道H使用的命令: CMD_WRITE_INPUT_REG 只写入，CMD_WRITE_INPUT_UPDATE_ALL 写入并更新全部通道。
+ * @param mask 输出: 发送的帧会更新的通道。
+ * @retval 需要发送的帧数。
+ */
+static uint8_t DAC8568_EncodeAllChannels(DAC8568_HandleTypeDef *hdac, const uint16_t *data_array, uint8_t last_cmd, uint8_t *mask)
+{
+    uint32_t head = DAC8568_EncodeFrame(CMD_WRITE_INPUT_REG, 0, 0, 0);
+    uint8_t count = 0;
+    *mask = 0;
+    for (uint8_t ch = 0; ch < 7; ch++) // 通道A到G只写输入寄存器
+    {
+        uint32_t frame = head | DAC8568_CODE_FRAME(0, ch, data_array[ch]);
+        if (DAC8568_ShadowFilter(hdac, frame))
+        {
+            *mask |= DAC8568_UpdateMask(&hdac->shadow, frame);
+            hdac->tx_buf[count++] = DAC8568_ToWire(hdac, frame);
+        }
+    }
+    uint32_t last = DAC8568_EncodeCode(last_cmd, CHANNEL_H, data_array[7]);
+    if (DAC8568_ShadowFilter(hdac, last))
+    {
+        *mask |= DAC8568_UpdateMask(&hdac->shadow, last);
+        hdac->tx_buf[count++] = DAC8568_ToWire(hdac, last);
+    }
+    return count;
 }
 
 /**
- * @brief 设置指定DAC通道或所有通道的电源模式。
- * @param channel 目标通道 (CHANNEL_A 到 CHANNEL_H) 或 BROADCAST。
- * @param mode 电源模式 (POWER_UP, POWER_DOWN_1K, POWER_DOWN_100K, POWER_DOWN_HIZ)。
- * @note 参考数据手册第47页表13。
+ * @brief 初始化DAC8568设备句柄。
+ * @param hdac 待初始化的设备句柄，需在整个使用期间保持有效 (通常定义为全局变量)。
+ * @param hspi SPI外设句柄指针。
+ * @param sync_port SYNC引脚的GPIO端口。
+ * @param sync_pin SYNC引脚的引脚号。
+ * @note 此函数会保存SPI和SYNC引脚的配置，并将SYNC引脚初始化为高电平。
+ *       默认执行软件复位，可选启用内部参考电压。
+ *       多片DAC8568可以共用一条SPI总线 (各自独立的SYNC引脚)，也可以分布在SPI1/SPI2上，
+ *       不同总线上的设备可以同时进行DMA传输。最多支持 DAC8568_MAX_DEVICES 个设备。
+ */
+void DAC8568_Init(DAC8568_HandleTypeDef *hdac, SPI_HandleTypeDef *hspi, GPIO_TypeDef *sync_port, uint16_t sync_pin)
+{
+    hdac->hspi = hspi;           // 保存SPI句柄
+    hdac->sync_port = sync_port; // 保存SYNC引脚的端口
+    hdac->sync_pin = sync_pin;   // 保存SYNC引脚的引脚号
+    hdac->ldac_port = NULL;      // 硬件LDAC引脚由 DAC8568_AttachLdacPin 指定
+    hdac->ldac_pin = 0;
+    hdac->spi16 = (hspi->Init.DataSize == SPI_DATASIZE_16BIT); // 按SPI数据帧宽度选择发送顺序
+    hdac->busy = 0;
+    hdac->streaming = 0;
+    hdac->skip_redundant = DAC8568_SKIP_REDUNDANT;
+    hdac->frames_skipped = 0;
+    hdac->shadow.valid = 0; // 芯片状态未知，直到下面的软件复位
+    hdac->queue_head = 0;
+    hdac->queue_tail = 0;
+    hdac->tx_queued = 0;
+    hdac->queue_overflows = 0;
+    hdac->callback = NULL;
+    hdac->tx_async = 0;
+    hdac->last_status = HAL_OK;
+#if DAC8568_TRACE
+    DAC8568_Trace_Reset(hdac);
+#endif
+
+    hdac->ext_ref_uv = DAC8568_EXTERNAL_REF_UV;
+    hdac->output_gain = DAC8568_OUTPUT_GAIN;
+    hdac->scale_ref = 0xFF;
+
+    DAC8568_Time_Init();
+    hdac->recovering = 0;
+    DAC8568_SetMinInterval(hdac, BROADCAST, DAC8568_MIN_INTERVAL_US);
+
+    // 注册句柄，供SPI传输完成回调查找 (重复初始化同一句柄不会重复注册)
+    uint8_t registered = 0;
+    for (uint8_t i = 0; i < dac_handle_count; i++)
+    {
+        if (dac_handles[i] == hdac)
+        {
+            registered = 1;
+        }
+    }
+    if (!registered && dac_handle_count < DAC8568_MAX_DEVICES)
+    {
+        dac_handles[dac_handle_count++] = hdac;
+    }
+
+    // 初始化SYNC引脚为高电平(空闲状态)
+    HAL_GPIO_WritePin(hdac->sync_port, hdac->sync_pin, GPIO_PIN_SET);
+
+    // 可选: 执行软件复位(参考数据手册第39页表6)
+    DAC8568_SoftwareReset(hdac); // 执行软件复位，确保DAC上电后处于已知的默认状态
+
+    // 可选: 启用内部参考(参考数据手册第44页表7)
+    // DAC8568_EnableStaticInternalRef(hdac); // 如果需要使用内部参考电压，取消此行注释
+}
+
+/**
+ * @brief 向DAC指定通道的输入寄存器写入数据。
+ * @param hdac DAC8568设备句柄。
+ * @param channel 目标DAC通道 (CHANNEL_A 到 CHANNEL_H, 或 BROADCAST)。
+ * @param data 要写入的码值 (原生分辨率，超出满量程时限幅)。
+ * @note 此操作仅更新输入寄存器，不会立即更新DAC的模拟输出。
+ *       参考数据手册第35页表4。
  */
-void DAC8568_SetPowerMode(uint8_t channel, uint8_t mode)
+void DAC8568_Write(DAC8568_HandleTypeDef *hdac, uint8_t channel, uint16_t data)
 {
-    uint8_t txData[4]; // 定义SPI传输的4字节数据缓冲区
+    // 命令位 CMD_WRITE_INPUT_REG (0000)，地址位为通道，数据位为16位DAC数据，特征位为0
+    DAC8568_TransmitFrame(hdac, DAC8568_EncodeCode(CMD_WRITE_INPUT_REG, channel, data));
+}
 
-    // 32位帧格式:
-    // [31:28] 前缀位(0000)
-    // [27:24] 命令位(CMD_POWER_DOWN = 0100) - 电源控制命令
-    // [23:20] 地址位(channel) - 选择目标通道或广播
-    // [19:10] 均为0 (不关心)
-    // [9:8]   PD1和PD0电源模式位 (位于整个SPI帧的DB9, DB8)
-    // [7:0]   均为0 (不关心, 包括特征位)
+/**
+ * @brief 更新DAC指定通道的输出。
+ * @param hdac DAC8568设备句柄。
+ * @param channel 目标DAC通道 (CHANNEL_A 到 CHANNEL_H, 或 BROADCAST)。
+ * @note 此操作会将对应通道输入寄存器中的值加载到DAC寄存器，从而更新模拟输出。
+ *       参考数据手册第36页表4。
+ */
+void DAC8568_Update(DAC8568_HandleTypeDef *hdac, uint8_t channel)
+{
+    // 命令位 CMD_UPDATE_DAC_REG (0001)，数据位与特征位不使用
+    DAC8568_TransmitFrame(hdac, DAC8568_EncodeFrame(CMD_UPDATE_DAC_REG, channel, 0, 0));
+}
 
-    // 第一个字节 (DB31-DB24): 前缀位 + 命令位
-    txData[0] = 0b00000000 | (CMD_POWER_DOWN & 0b00001111);
+/**
+ * @brief 向DAC指定通道的输入寄存器写入数据并立即更新其模拟输出。
+ * @param hdac DAC8568设备句柄。
+ * @param channel 目标DAC通道 (CHANNEL_A 到 CHANNEL_H)。
+ * @param data 要写入的码值 (原生分辨率，超出满量程时限幅)。
+ * @note 参考数据手册第37页表4。
+ */
+void DAC8568_WriteAndUpdate(DAC8568_HandleTypeDef *hdac, uint8_t channel, uint16_t data)
+{
+    // 命令位 CMD_WRITE_INPUT_UPDATE_ONE (0011) - 写入输入寄存器并更新单个DAC
+    DAC8568_TransmitFrame(hdac, DAC8568_EncodeCode(CMD_WRITE_INPUT_UPDATE_ONE, channel, data));
+}
 
-    // 第二个字节 (DB23-DB16): 地址位 + 数据高4位(此命令中为0)
-    txData[1] = ((channel & 0b00001111) << 4) | 0b00000000;
+/**
+ * @brief 将数据数组中的值分别写入所有8个DAC通道的输入寄存器。
+ * @param hdac DAC8568设备句柄。
+ * @param data_array 包含8个码值 (原生分辨率) 的数组指针，分别对应通道A到H。
+ * @note 8帧一次性编码后连续发送 (DMA模式下中断链式发送，函数立即返回)。
+ *       影子寄存器有效时只发送值有变化的通道。
+ *       此操作不更新模拟输出，需要同时更新请使用 DAC8568_WriteAndUpdateAllChannels。
+ *       参考数据手册第36页表4。
+ */
+void DAC8568_WriteAllChannels(DAC8568_HandleTypeDef *hdac, uint16_t *data_array) // 参数为包含8个通道数据的数组指针
+{
+    if (!DAC8568_Acquire(hdac))
+    {
+        return;
+    }
+    uint8_t mask;
+    uint8_t count = DAC8568_EncodeAllChannels(hdac, data_array, CMD_WRITE_INPUT_REG, &mask);
+    DAC8568_Throttle(hdac, mask);
+    DAC8568_TransmitBurst(hdac, hdac->tx_buf, count);
+    DAC8568_Stamp(hdac, mask);
+}
 
-    // 第三个字节 (DB15-DB8): 包含电源模式位 PD1(DB9) 和 PD0(DB8)
-    // (mode & 0b00000011) 提取 mode 参数中的 PD1(bit1) 和 PD0(bit0)。
-    // 这些位对应SPI帧的DB9和DB8，因此直接放入 txData[2] 的最低两位。
-    // txData[2] 的高6位 (DB15-DB10) 为 不关心 (设为0)。
-    txData[2] = (mode & 0b00000011); // PD1位于bit1, PD0位于bit0 of txData[2] (对应帧的D9, D8)
+/**
+ * @brief 写入全部8个通道并同时更新所有模拟输出。
+ * @param hdac DAC8568设备句柄。
+ * @param data_array 包含8个码值 (原生分辨率) 的数组指针，分别对应通道A到H。
+ * @note 通道A-G使用 CMD_WRITE_INPUT_REG 只写输入寄存器，通道H使用 CMD_WRITE_INPUT_UPDATE_ALL
+ *       写入并同时把8个输入寄存器加载到DAC寄存器，8个输出在最后一帧的SYNC上升沿同时变化，
+ *       不会出现通道间先后更新造成的毛刺，也不需要额外的广播更新帧。
+ *       影子寄存器有效时跳过值未变化的通道A-G；只要有任一输出需要变化，最后的全部更新帧照常发送，
+ *       仍保证同时更新。
+ *       参考数据手册第36页表4。
+ */
+void DAC8568_WriteAndUpdateAllChannels(DAC8568_HandleTypeDef *hdac, const uint16_t *data_array)
+{
+    if (!DAC8568_Acquire(hdac))
+    {
+        return;
+    }
+    uint8_t mask;
+    uint8_t count = DAC8568_EncodeAllChannels(hdac, data_array, CMD_WRITE_INPUT_UPDATE_ALL, &mask);
+    DAC8568_Throttle(hdac, mask);
+    DAC8568_TransmitBurst(hdac, hdac->tx_buf, count);
+    DAC8568_Stamp(hdac, mask);
+}
 
-    // 第四个字节 (DB7-DB0): 均为0 (不关心)
-    txData[3] = 0;
+/**
+ * @brief 更新所有DAC通道的模拟输出。
+ * @param hdac DAC8568设备句柄。
+ * @note 此函数使用CMD_UPDATE_DAC_REG命令和BROADCAST地址。
+ *       参考数据手册第36页表4。
+ */
+void DAC8568_UpdateAllChannels(DAC8568_HandleTypeDef *hdac)
+{
+    DAC8568_TransmitFrame(hdac, DAC8568_EncodeFrame(CMD_UPDATE_DAC_REG, BROADCAST, 0, 0));
+}
 
-    // 执行SPI传输
-    HAL_GPIO_WritePin(SYNC_PORT, SYNC_PIN, GPIO_PIN_RESET);
-    HAL_SPI_Transmit(hspi_dac, txData, 4, HAL_MAX_DELAY);
-    HAL_GPIO_WritePin(SYNC_PORT, SYNC_PIN, GPIO_PIN_SET);
+/**
+ * @brief 设置指定DAC通道或所有通道的电源模式。
+ * @param hdac DAC8568设备句柄。
+ * @param channel 目标通道 (CHANNEL_A 到 CHANNEL_H) 或 BROADCAST。
+ * @param mode 电源模式 (POWER_UP, POWER_DOWN_1K, POWER_DOWN_100K, POWER_DOWN_HIZ)。
+ * @note 参考数据手册第47页表13。
+ *       PD1和PD0电源模式位位于整个SPI帧的DB9, DB8，即16位数据字段的D5, D4。
+ *       通道选择位于DB7-DB0 (DB0对应通道A)，地址位不关心。
+ */
+void DAC8568_SetPowerMode(DAC8568_HandleTypeDef *hdac, uint8_t channel, uint8_t mode)
+{
+    uint8_t mask = (channel == BROADCAST) ? 0xFF : (uint8_t)(1U << (channel & 0x07));
+    DAC8568_TransmitFrame(hdac, DAC8568_EncodeFrame(CMD_POWER_DOWN, 0, 0, 0) | ((uint32_t)(mode & 0b00000011) << 8) | mask);
 }
 
 /**
  * @brief 启用静态内部参考电压（2.5V）。
+ * @param hdac DAC8568设备句柄。
  * @note 参考数据手册第44页表7。命令 CMD_INTERNAL_REF, 地址 0b0000, 特征位 REF_ENABLE。内部参考电压为2.5V，但是在C/D等级中内部会有一个2倍增益。见数据手册31页8.2.1
  */
-void DAC8568_EnableStaticInternalRef(void)
+void DAC8568_EnableStaticInternalRef(DAC8568_HandleTypeDef *hdac)
 {
-    DAC8568_SendRawCommand(CMD_INTERNAL_REF, 0b0000, 0x0000, REF_ENABLE);
+    DAC8568_SendRawCommand(hdac, CMD_INTERNAL_REF, 0b0000, 0x0000, REF_ENABLE);
 }
 
 /**
  * @brief 禁用静态内部参考电压（2.5V）。
+ * @param hdac DAC8568设备句柄。
  * @note 参考数据手册第44页表7。命令 CMD_INTERNAL_REF, 地址 0b0000, 特征位 REF_DISABLE。内部参考电压为2.5V，但是在C/D等级中内部会有一个2倍增益。见数据手册31页8.2.1
  */
-void DAC8568_DisableStaticInternalRef(void)
+void DAC8568_DisableStaticInternalRef(DAC8568_HandleTypeDef *hdac)
 {
-    DAC8568_SendRawCommand(CMD_INTERNAL_REF, 0b0000, 0x0000, REF_DISABLE);
+    DAC8568_SendRawCommand(hdac, CMD_INTERNAL_REF, 0b0000, 0x0000, REF_DISABLE);
 }
 
 /**
  * @brief 启用内部参考的灵活模式 (Flex Mode)。
+ * @param hdac DAC8568设备句柄。
  * @note 参考数据手册第45页表9。命令 CMD_INTERNAL_REF, 地址 0b0001, 数据位 D13=1, 特征位 0b0000。
  */
-void DAC8568_EnableFlexMode(void)
+void DAC8568_EnableFlexMode(DAC8568_HandleTypeDef *hdac)
 {
     // 数据位 D13 (对应整个16位数据字段的 bit 13) 设置为1
-    DAC8568_SendRawCommand(CMD_INTERNAL_REF, 0b0001, (1 << 13), 0b0000);
+    DAC8568_SendRawCommand(hdac, CMD_INTERNAL_REF, 0b0001, (1 << 13), 0b0000);
 }
 
 /**
  * @brief 禁用内部参考的灵活模式 (Flex Mode)。
+ * @param hdac DAC8568设备句柄。
  * @note 参考数据手册第45页表9。命令 CMD_INTERNAL_REF, 地址 0b0001, 数据位 D13=0, 特征位 0b0000。
  *       禁用灵活模式后，内部参考的行为由静态模式控制位决定。
  */
-void DAC8568_DisableFlexMode(void)
+void DAC8568_DisableFlexMode(DAC8568_HandleTypeDef *hdac)
 {
     // 数据位 D13 设置为0
-    DAC8568_SendRawCommand(CMD_INTERNAL_REF, 0b0001, 0x0000, 0b0000);
+    DAC8568_SendRawCommand(hdac, CMD_INTERNAL_REF, 0b0001, 0x0000, 0b0000);
 }
 
 /**
  * @brief 在灵活模式下，设置内部参考是否始终开启。
+ * @param hdac DAC8568设备句柄。
  * @param enable 1 表示始终开启, 0 表示根据需要自动开启/关闭 (默认行为)。
  * @note 参考数据手册第45页表10。命令 CMD_INTERNAL_REF, 地址 0b0001, 数据位 D15 控制, 特征位 0b0000。
  */
-void DAC8568_SetFlexModeRefAlwaysOn(uint8_t enable)
+void DAC8568_SetFlexModeRefAlwaysOn(DAC8568_HandleTypeDef *hdac, uint8_t enable)
 {
     uint16_t data_bits = enable ? (1 << 15) : 0; // D15 控制
-    DAC8568_SendRawCommand(CMD_INTERNAL_REF, 0b0001, data_bits, 0b0000);
+    DAC8568_SendRawCommand(hdac, CMD_INTERNAL_REF, 0b0001, data_bits, 0b0000);
 }
 
 /**
  * @brief 在灵活模式下，设置内部参考是否始终关闭。
+ * @param hdac DAC8568设备句柄。
  * @param enable 1 表示始终关闭, 0 表示根据需要自动开启/关闭。
  * @note 参考数据手册第45页表11。命令 CMD_INTERNAL_REF, 地址 0b0001, 数据位 D14 控制, 特征位 0b0000。
  */
-void DAC8568_SetFlexModeRefAlwaysOff(uint8_t enable)
+void DAC8568_SetFlexModeRefAlwaysOff(DAC8568_HandleTypeDef *hdac, uint8_t enable)
 {
     uint16_t data_bits = enable ? (1 << 14) : 0; // D14 控制
-    DAC8568_SendRawCommand(CMD_INTERNAL_REF, 0b0001, data_bits, 0b0000);
+    DAC8568_SendRawCommand(hdac, CMD_INTERNAL_REF, 0b0001, data_bits, 0b0000);
 }
 
 /**
  * @brief 设置DAC清零时的行为。
+ * @param hdac DAC8568设备句柄。
  * @param mode 清除代码模式 (CLEAR_CODE_ZERO_SCALE, CLEAR_CODE_MID_SCALE, CLEAR_CODE_FULL_SCALE, CLEAR_CODE_NO_OPERATION)。
  * @note 参考数据手册第39页表5。
+ *       特征位 F1, F0 (CC1, CC0) 位于整个SPI帧的DB1, DB0，地址位与数据位不关心。
  */
-void DAC8568_SetClearCode(uint8_t mode)
+void DAC8568_SetClearCode(DAC8568_HandleTypeDef *hdac, uint8_t mode)
 {
-    uint8_t txData[4]; // 定义SPI传输的4字节数据缓冲区
-
-    // 32位帧格式:
-    // [31:28] 前缀位(0000)
-    // [27:24] 命令位(CMD_CLEAR_CODE_REG = 0101) - 清除代码寄存器命令
-    // [23:4]  均为0 (不关心)
-    // [3:2]   特征位 F1, F0 (位于整个SPI帧的DB3, DB2) 控制清除模式
-    // [1:0]   均为0 (不关心)
-
-    // 第一个字节 (DB31-DB24): 前缀位 + 命令位
-    txData[0] = 0b00000000 | (CMD_CLEAR_CODE_REG & 0b00001111);
-
-    // 第二个字节 (DB23-DB16): 地址位(不关心, 设为0) + 数据高位(不关心, 设为0)
-    txData[1] = 0b00000000;
-
-    // 第三个字节 (DB15-DB8): 数据中间位(不关心, 设为0)
-    txData[2] = 0;
-
-    // 第四个字节 (DB7-DB0): 包含特征位 F1, F0
-    // (mode & 0b00000011) 提取 mode 参数的最低两位作为 F1(bit1)F0(bit0)。
-    // 左移2位，将它们放置到SPI帧的DB3和DB2位置。
-    txData[3] = (mode & 0b00000011) << 2; // F1(DB3), F0(DB2) 控制清除模式
-
-    // 执行SPI传输
-    HAL_GPIO_WritePin(SYNC_PORT, SYNC_PIN, GPIO_PIN_RESET);
-    HAL_SPI_Transmit(hspi_dac, txData, 4, HAL_MAX_DELAY);
-    HAL_GPIO_WritePin(SYNC_PORT, SYNC_PIN, GPIO_PIN_SET);
+    DAC8568_TransmitFrame(hdac, DAC8568_EncodeFrame(CMD_CLEAR_CODE_REG, 0, 0, (uint8_t)(mode & 0b00000011)));
 }
 
 /**
- * @brief 执行软件复位。
- * @note 将DAC所有寄存器恢复到上电默认状态。
- *       参考数据手册第39页表6。
- *       软件复位后建议等待一小段时间 (例如1ms)。
+ * @brief 设置LDAC寄存器。
+ * @param hdac DAC8568设备句柄。
+ * @param mask 通道掩码，bit0对应通道A。对应位为1的通道在写入输入寄存器时立即更新输出，
+ *             不再需要更新命令；为0的通道等待更新命令或硬件LDAC脉冲。
+ * @note 参考数据手册第35-47页命令表。命令 CMD_LDAC_REG，DB7-DB0 为通道掩码
+ *       (数据位的低4位与特征位)。上电与软件复位后为0。
  */
-void DAC8568_SoftwareReset(void)
+void DAC8568_SetLdacMask(DAC8568_HandleTypeDef *hdac, uint8_t mask)
 {
-    uint8_t txData[4]; // 定义SPI传输的4字节数据缓冲区
+    DAC8568_TransmitFrame(hdac, DAC8568_EncodeFrame(CMD_LDAC_REG, 0, (uint16_t)(mask >> 4), (uint8_t)(mask & 0x0F)));
+}
 
-    // 32位帧格式:
-    // [31:28] 前缀位(0000)
-    // [27:24] 命令位(CMD_SOFTWARE_RESET = 0111) - 软件复位命令
-    // [23:0]  均为0 (不关心)
+/**
+ * @brief 指定连接到DAC8568 LDAC引脚的GPIO。
+ * @param hdac DAC8568设备句柄。
+ * @param ldac_port LDAC引脚的GPIO端口 (如 LDAC_GPIO_Port)，NULL表示未连接。
+ * @param ldac_pin LDAC引脚号 (如 LDAC_Pin)。
+ * @note 引脚应已配置为推挽输出 (MX_GPIO_Init)，此处将其置为空闲的高电平。
+ */
+void DAC8568_AttachLdacPin(DAC8568_HandleTypeDef *hdac, GPIO_TypeDef *ldac_port, uint16_t ldac_pin)
+{
+    hdac->ldac_port = ldac_port;
+    hdac->ldac_pin = ldac_pin;
+    if (ldac_port != NULL)
+    {
+        HAL_GPIO_WritePin(ldac_port, ldac_pin, GPIO_PIN_SET);
+    }
+}
+
+/**
+ * @brief 在硬件LDAC引脚上输出一个低脉冲，所有通道同时以输入寄存器的内容更新输出。
+ * @param hdac DAC8568设备句柄。
+ * @note 先等待正在进行的DMA传输结束，保证最后写入的输入寄存器被锁存。
+ *       两次 HAL_GPIO_WritePin 之间的时间已大于数据手册要求的LDAC最短低电平宽度。
+ *       常见用法: DAC8568_WriteAllChannels 随时写入8个输入寄存器，在需要的时刻调用本函数同时更新，
+ *       总线时序与输出时刻无关，也不需要额外的更新帧。未连接LDAC引脚时不做任何操作。
+ */
+void DAC8568_PulseLdac(DAC8568_HandleTypeDef *hdac)
+{
+    if (hdac->ldac_port == NULL)
+    {
+        return;
+    }
+
+    DAC8568_WaitForTransfer(hdac);
+    DAC8568_Throttle(hdac, 0xFF);
+    HAL_GPIO_WritePin(hdac->ldac_port, hdac->ldac_pin, GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(hdac->ldac_port, hdac->ldac_pin, GPIO_PIN_SET);
+    DAC8568_Stamp(hdac, 0xFF);
 
-    // 第一个字节 (DB31-DB24): 前缀位 + 命令位
-    txData[0] = 0b00000000 | (CMD_SOFTWARE_RESET & 0b00001111);
-    // 其余字节 (DB23-DB0) 均为 不关心，设为0
-    txData[1] = 0;
-    txData[2] = 0;
-    txData[3] = 0;
+    for (uint8_t ch = 0; ch < 8; ch++)
+    {
+        hdac->shadow.dac_reg[ch] = hdac->shadow.input_reg[ch];
+    }
+}
 
-    // 执行SPI传输
-    HAL_GPIO_WritePin(SYNC_PORT, SYNC_PIN, GPIO_PIN_RESET);
-    HAL_SPI_Transmit(hspi_dac, txData, 4, HAL_MAX_DELAY);
-    HAL_GPIO_WritePin(SYNC_PORT, SYNC_PIN, GPIO_PIN_SET);
-    HAL_Delay(1); // 根据数据手册建议，软件复位后等待一小段时间 (1ms为保守值)
+/**
+ * @brief 执行软件复位。
+ * @param hdac DAC8568设备句柄。
+ * @note 将DAC所有寄存器恢复到上电默认状态。
+ *       参考数据手册第39页表6。
+ *       复位帧发出后立即返回，此后发送的第一帧之前等待 DAC8568_RESET_RECOVERY_US，
+ *       期间CPU可以做其它工作，不再固定占用1ms的HAL_Delay。
+ */
+void DAC8568_SoftwareReset(DAC8568_HandleTypeDef *hdac)
+{
+    // 命令位 CMD_SOFTWARE_RESET (0111)，其余位不关心
+    DAC8568_TransmitFrame(hdac, DAC8568_EncodeFrame(CMD_SOFTWARE_RESET, 0, 0, 0));
+    DAC8568_WaitForTransfer(hdac); // DMA模式下需等待复位帧真正发出后再开始计时
+    hdac->ready_at = DWT->CYCCNT + dac_reset_cycles;
+    hdac->recovering = 1;
 }
 
 /**
  * @brief 直接发送一个完整的32位命令帧到DAC8568。
+ * @param hdac DAC8568设备句柄。
  * @param cmd_bits 4位命令位 (DB27-DB24)。
  * @param addr_bits 4位地址位 (DB23-DB20)。
  * @param data_bits 16位数据位 (DB19-DB4)。
  * @param feature_bits 4位特征位 (DB3-DB0)。
  * @note 前缀位 (DB31-DB28) 固定为0b0000。
  */
-void DAC8568_SendRawCommand(uint8_t cmd_bits, uint8_t addr_bits, uint16_t data_bits, uint8_t feature_bits)
+void DAC8568_SendRawCommand(DAC8568_HandleTypeDef *hdac, uint8_t cmd_bits, uint8_t addr_bits, uint16_t data_bits, uint8_t feature_bits)
 {
-    uint8_t txData[4]; // 使用4字节(32位)传输
+    DAC8568_TransmitFrame(hdac, DAC8568_EncodeFrame(cmd_bits, addr_bits, data_bits, feature_bits));
+}
 
-    // 32位帧格式:
-    // [31:28] 前缀位(0000)
-    // [27:24] 命令位(cmd_bits)
-    // [23:20] 地址位(addr_bits)
-    // [19:4]  数据位(data_bits)
-    // [3:0]   特征位(feature_bits)
+/**
+ * @brief 直接发送自定义的4字节原始数据到DAC8568。
+ * @param hdac DAC8568设备句柄。
+ * @param raw_data 指向包含4字节数据的数组。
+ * @note 此函数用于发送预先构建好的完整SPI帧。
+ */
+void DAC8568_SendRawData(DAC8568_HandleTypeDef *hdac, uint8_t raw_data[4])
+{
+    // raw_data[0]最先发送 (DB31-DB24)，先组合为数值形式再按SPI数据帧宽度转换
+    uint32_t frame = ((uint32_t)raw_data[0] << 24) | ((uint32_t)raw_data[1] << 16) |
+                     ((uint32_t)raw_data[2] << 8) | raw_data[3];
+    DAC8568_TransmitFrame(hdac, frame);
+}
 
-    // 第一个字节:
-    // 7-4位: 前缀位(0000)
-    // 3-0位: 命令位
-    txData[0] = 0b00000000 | (cmd_bits & 0b00001111);
+/**
+ * @brief 将一串数据编码为同一命令、同一通道的线上顺序帧，存入调用者提供的缓冲区。
+ * @param hdac DAC8568设备句柄。
+ * @param frames 输出缓冲区，至少 count 个元素。
+ * @param cmd_bits 4位命令位 (如 CMD_WRITE_INPUT_UPDATE_ONE)。
+ * @param channel 目标通道或 BROADCAST。
+ * @param data 码值数组 (原生分辨率)。
+ * @param count 帧数。
+ * @note 编码结果可由 DAC8568_SendFrames 反复发送，避免每次调用重新打包。
+ */
+void DAC8568_EncodeFrames(DAC8568_HandleTypeDef *hdac, uint32_t *frames, uint8_t cmd_bits, uint8_t channel, const uint16_t *data, uint16_t count)
+{
+    uint32_t head = DAC8568_EncodeFrame(cmd_bits, channel, 0, 0); // 命令位与地址位只需编码一次
+    if (hdac->spi16)
+    {
+        for (uint16_t i = 0; i < count; i++)
+        {
+            frames[i] = DAC8568_FrameToHalfWords(head | DAC8568_CODE_FRAME(0, 0, data[i]));
+        }
+    }
+    else
+    {
+        for (uint16_t i = 0; i < count; i++)
+        {
+            frames[i] = DAC8568_FrameToWire(head | DAC8568_CODE_FRAME(0, 0, data[i]));
+        }
+    }
+}
 
-    // 第二个字节:
-    // 7-4位: 地址位
-    // 3-0位: 数据高4位(19-16位)
-    txData[1] = ((addr_bits & 0b00001111) << 4) | ((data_bits >> 12) & 0b00001111);
+/**
+ * @brief 依次发送预编码的线上顺序帧。
+ * @param hdac DAC8568设备句柄。
+ * @param frames 由 DAC8568_EncodeFrames 生成的帧数组 (或按SPI数据帧宽度
+ *               由 DAC8568_FrameToWire / DAC8568_FrameToHalfWords 转换)。
+ *               DMA模式下函数立即返回，在 DAC8568_IsBusy 返回0之前不得修改或释放该数组。
+ * @param count 帧数，每帧独立拉低/拉高一次SYNC。
+ * @note 预编码帧按原样全部发送 (不跳过冗余帧)，但会据此更新影子寄存器。
+ */
+void DAC8568_SendFrames(DAC8568_HandleTypeDef *hdac, const uint32_t *frames, uint16_t count)
+{
+    if (!DAC8568_Acquire(hdac))
+    {
+        return;
+    }
+    for (uint16_t i = 0; i < count; i++)
+    {
+        DAC8568_ShadowApply(&hdac->shadow, DAC8568_ToWire(hdac, frames[i])); // REV与半字交换均为自逆变换
+    }
+    DAC8568_Throttle(hdac, 0); // 预编码帧只等待复位恢复，帧间隔由调用者决定
+    DAC8568_TransmitBurst(hdac, frames, count);
+}
 
-    // 第三个字节:
-    // 7-0位: 数据中间8位(15-8位)
-    txData[2] = (data_bits >> 4) & 0xFF;
+/**
+ * @brief 由影子寄存器判断当前使用的是否为内部参考。
+ * @param shadow 影子寄存器。
+ * @retval 1 内部参考，0 外部参考。
+ * @note 灵活模式的常开 (D15) / 常关 (D14) 优先，其次为灵活模式使能 (D13，有通道上电时参考开启)，
+ *       否则由静态模式决定。参考数据手册第44-45页表7-11。
+ */
+static uint8_t DAC8568_RefIsInternal(const DAC8568_ShadowTypeDef *shadow)
+{
+    if (shadow->ref_flex & (1U << 15))
+    {
+        return 1;
+    }
+    if (shadow->ref_flex & (1U << 14))
+    {
+        return 0;
+    }
+    if (shadow->ref_flex & (1U << 13))
+    {
+        return 1;
+    }
+    return shadow->ref_static;
+}
 
-    // 第四个字节:
-    // 7-4位: 数据低4位(7-4位)
-    // 3-0位: 特征位
-    txData[3] = ((data_bits & 0b00001111) << 4) | (feature_bits & 0b00001111);
+/**
+ * @brief 返回当前参考对应的μV→码值系数，参考改变后重新计算。
+ * @param hdac DAC8568设备句柄。
+ * @retval Q32系数: 码值 = (μV × 系数) >> 32。
+ * @note 只有参考、增益或外部参考电压改变后的第一次调用包含64位除法。
+ */
+static uint32_t DAC8568_GetScale(DAC8568_HandleTypeDef *hdac)
+{
+    uint8_t internal = DAC8568_RefIsInternal(&hdac->shadow);
+    if (hdac->scale_ref != internal)
+    {
+        uint32_t fs = (internal ? DAC8568_INTERNAL_REF_UV : hdac->ext_ref_uv) * hdac->output_gain;
+        hdac->uv_to_code = (fs > DAC8568_MAX_CODE) ? (uint32_t)((((uint64_t)DAC8568_MAX_CODE + 1U) << 32) / fs) : 0;
+        hdac->scale_ref = internal;
+    }
+    return hdac->uv_to_code;
+}
 
-    // 开始传输(拉低SYNC)
-    HAL_GPIO_WritePin(SYNC_PORT, SYNC_PIN, GPIO_PIN_RESET);
+/**
+ * @brief 按系数把电压换算为码值。
+ * @param scale DAC8568_GetScale 返回的Q32系数。
+ * @param microvolts 输出电压 (μV)。
+ * @retval 原生分辨率码值，四舍五入，超过满量程时饱和。
+ */
+static inline uint16_t DAC8568_ScaleToCode(uint32_t scale, uint32_t microvolts)
+{
+    uint32_t code = (uint32_t)(((uint64_t)microvolts * scale + 0x80000000U) >> 32);
+    return (uint16_t)((code > DAC8568_MAX_CODE) ? DAC8568_MAX_CODE : code);
+}
 
-    // SPI传输
-    HAL_SPI_Transmit(hspi_dac, txData, 4, HAL_MAX_DELAY); // 传输4字节
+/**
+ * @brief mV换算为μV。
+ * @param millivolts 输出电压 (mV)。
+ * @retval 输出电压 (μV)，超过4294967mV时饱和为 UINT32_MAX (远高于满量程，码值随后饱和)。
+ */
+static inline uint32_t DAC8568_MillivoltsToMicrovolts(uint32_t millivolts)
+{
+    return (millivolts > UINT32_MAX / 1000U) ? UINT32_MAX : millivolts * 1000U;
+}
 
-    // 结束传输(拉高SYNC)
-    HAL_GPIO_WritePin(SYNC_PORT, SYNC_PIN, GPIO_PIN_SET);
+/**
+ * @brief 设置外部参考电压。
+ * @param hdac DAC8568设备句柄。
+ * @param microvolts VREFIN引脚上的电压 (μV)。
+ * @note 内部参考关闭时用于电压换算。
+ */
+void DAC8568_SetExternalRef(DAC8568_HandleTypeDef *hdac, uint32_t microvolts)
+{
+    hdac->ext_ref_uv = microvolts;
+    hdac->scale_ref = 0xFF;
 }
 
 /**
- * @brief 直接发送自定义的4字节原始数据到DAC8568。
- * @param raw_data 指向包含4字节数据的数组。
- * @note 此函数用于发送预先构建好的完整SPI帧。
+ * @brief 设置输出缓冲增益。
+ * @param hdac DAC8568设备句柄。
+ * @param gain 1或2，取决于器件等级 (数据手册31页8.2.1)。
+ */
+void DAC8568_SetOutputGain(DAC8568_HandleTypeDef *hdac, uint8_t gain)
+{
+    hdac->output_gain = gain;
+    hdac->scale_ref = 0xFF;
+}
+
+/**
+ * @brief 查询当前的满量程输出电压。
+ * @param hdac DAC8568设备句柄。
+ * @retval 参考电压 × 输出增益 (μV)，按影子寄存器记录的参考状态选择内部或外部参考。
+ */
+uint32_t DAC8568_GetFullScaleMicrovolts(DAC8568_HandleTypeDef *hdac)
+{
+    return (DAC8568_RefIsInternal(&hdac->shadow) ? DAC8568_INTERNAL_REF_UV : hdac->ext_ref_uv) * hdac->output_gain;
+}
+
+/**
+ * @brief 电压换算为码值。
+ * @param hdac DAC8568设备句柄。
+ * @param microvolts 输出电压 (μV)。
+ * @retval 原生分辨率码值，四舍五入，超过满量程时饱和。
+ * @note 一次32×32→64位乘法 (UMULL) 与移位，没有除法和浮点运算。
+ */
+uint16_t DAC8568_MicrovoltsToCode(DAC8568_HandleTypeDef *hdac, uint32_t microvolts)
+{
+    return DAC8568_ScaleToCode(DAC8568_GetScale(hdac), microvolts);
+}
+
+/**
+ * @brief 设置通道输出电压 (写入并立即更新)。
+ * @param hdac DAC8568设备句柄。
+ * @param channel 通道 (CHANNEL_A 到 CHANNEL_H) 或 BROADCAST。
+ * @param microvolts 输出电压 (μV)。
+ * @note 参考随 DAC8568_EnableStaticInternalRef 等命令自动跟踪，外部参考电压见 DAC8568_SetExternalRef。
+ */
+void DAC8568_SetMicrovolts(DAC8568_HandleTypeDef *hdac, uint8_t channel, uint32_t microvolts)
+{
+    DAC8568_WriteAndUpdate(hdac, channel, DAC8568_MicrovoltsToCode(hdac, microvolts));
+}
+
+/**
+ * @brief 设置通道输出电压 (写入并立即更新)。
+ * @param hdac DAC8568设备句柄。
+ * @param channel 通道 (CHANNEL_A 到 CHANNEL_H) 或 BROADCAST。
+ * @param millivolts 输出电压 (mV)，超过满量程时饱和。
+ */
+void DAC8568_SetMillivolts(DAC8568_HandleTypeDef *hdac, uint8_t channel, uint32_t millivolts)
+{
+    DAC8568_WriteAndUpdate(hdac, channel, DAC8568_MicrovoltsToCode(hdac, DAC8568_MillivoltsToMicrovolts(millivolts)));
+}
+
+/**
+ * @brief 设置全部8个通道的输出电压并同时更新。
+ * @param hdac DAC8568设备句柄。
+ * @param millivolts 通道A到H的输出电压 (mV)，超过满量程时饱和。
+ * @note 系数只取一次，8次乘法后经 DAC8568_WriteAndUpdateAllChannels 发送。
+ */
+void DAC8568_SetMillivoltsAllChannels(DAC8568_HandleTypeDef *hdac, const uint32_t *millivolts)
+{
+    uint32_t scale = DAC8568_GetScale(hdac);
+    uint16_t codes[8];
+    for (uint8_t ch = 0; ch < 8; ch++)
+    {
+        codes[ch] = DAC8568_ScaleToCode(scale, DAC8568_MillivoltsToMicrovolts(millivolts[ch]));
+    }
+    DAC8568_WriteAndUpdateAllChannels(hdac, codes);
+}
+
+/**
+ * @brief 设置通道两次输出更新之间的最小间隔。
+ * @param hdac DAC8568设备句柄。
+ * @param channel 通道 (CHANNEL_A 到 CHANNEL_H) 或 BROADCAST (全部通道)。
+ * @param us 最小间隔 (μs)，0为不限制。
+ * @note 同步函数在间隔未满足时忙等待剩余的时间 (以DWT周期计，不会等满1ms)；
+ *       异步函数不等待而是返回 HAL_BUSY。命令队列与预编码帧不受此限制。
+ *       建立时间: 典型5μs，最大10μs (数据手册第7页)。
  */
-void DAC8568_SendRawData(uint8_t raw_data[4])
+void DAC8568_SetMinInterval(DAC8568_HandleTypeDef *hdac, uint8_t channel, uint32_t us)
 {
-    // 开始传输(拉低SYNC)
-    HAL_GPIO_WritePin(SYNC_PORT, SYNC_PIN, GPIO_PIN_RESET);
+    uint8_t mask = (channel == BROADCAST) ? 0xFF : (uint8_t)(1U << (channel & 0x07));
+    uint32_t cycles = DAC8568_UsToCycles(us);
+    uint32_t now = DWT->CYCCNT;
+    for (uint8_t ch = 0; ch < 8; ch++)
+    {
+        if (mask & (1U << ch))
+        {
+            hdac->min_interval[ch] = cycles;
+            hdac->not_before[ch] = now; // 立即允许更新
+        }
+    }
+    hdac->throttle_mask = 0;
+    for (uint8_t ch = 0; ch < 8; ch++)
+    {
+        if (hdac->min_interval[ch] != 0)
+        {
+            hdac->throttle_mask |= (uint8_t)(1U << ch);
+        }
+    }
+}
 
-    // SPI传输
-    HAL_SPI_Transmit(hspi_dac, raw_data, 4, HAL_MAX_DELAY); // 传输4字节
+/**
+ * @brief 注册异步传输完成回调。
+ * @param hdac DAC8568设备句柄。
+ * @param callback 回调函数，NULL表示不通知 (可通过 DAC8568_IsBusy 与 DAC8568_GetLastStatus 查询)。
+ * @note 只对 *_Async 函数启动的传输调用，同步函数与命令队列不触发回调。
+ */
+void DAC8568_RegisterCallback(DAC8568_HandleTypeDef *hdac, DAC8568_CallbackTypeDef callback)
+{
+    hdac->callback = callback;
+}
 
-    // 结束传输(拉高SYNC)
-    HAL_GPIO_WritePin(SYNC_PORT, SYNC_PIN, GPIO_PIN_SET);
-}
\ No newline at end of file
+/**
+ * @brief 不等待地获取发送权。
+ * @param hdac DAC8568设备句柄。
+ * @retval HAL_OK 可以发送；HAL_BUSY 本设备或同一总线上的其它设备正在传输；HAL_ERROR 流式输出占用中。
+ */
+static HAL_StatusTypeDef DAC8568_TryAcquire(DAC8568_HandleTypeDef *hdac)
+{
+    if (hdac->streaming)
+    {
+        return HAL_ERROR;
+    }
+    if (hdac->busy || hdac->hspi->State != HAL_SPI_STATE_READY)
+    {
+        return HAL_BUSY;
+    }
+    return HAL_OK;
+}
+
+/**
+ * @brief 启动一次异步传输。
+ * @param hdac DAC8568设备句柄，已通过 DAC8568_TryAcquire 获取发送权。
+ * @param wire 线上顺序帧数组 (句柄的发送缓冲区或调用者的数组)。
+ * @param count 帧数，0表示全部为冗余帧，立即完成。
+ * @retval 启动结果 (阻塞模式下为发送结果)。
+ */
+static HAL_StatusTypeDef DAC8568_StartAsync(DAC8568_HandleTypeDef *hdac, const uint32_t *wire, uint16_t count)
+{
+    hdac->tx_async = 1;
+    hdac->last_status = HAL_BUSY; // 传输进行中
+    return DAC8568_TransmitBurst(hdac, wire, count);
+}
+
+/**
+ * @brief 启动单帧异步传输。
+ * @param hdac DAC8568设备句柄，已通过 DAC8568_TryAcquire 获取发送权。
+ * @param frame 数值形式的帧。
+ * @retval HAL_BUSY 复位恢复或通道最小间隔未结束 (不等待，帧未发送)；其余同 DAC8568_StartAsync。
+ */
+static HAL_StatusTypeDef DAC8568_StartAsyncFrame(DAC8568_HandleTypeDef *hdac, uint32_t frame)
+{
+    uint8_t mask = DAC8568_UpdateMask(&hdac->shadow, frame);
+    if (!DAC8568_TimingReady(hdac, mask))
+    {
+        return HAL_BUSY;
+    }
+    uint8_t count = DAC8568_ShadowFilter(hdac, frame);
+    hdac->tx_buf[0] = DAC8568_ToWire(hdac, frame);
+    HAL_StatusTypeDef status = DAC8568_StartAsync(hdac, hdac->tx_buf, count);
+    DAC8568_Stamp(hdac, count ? mask : 0);
+    return status;
+}
+
+/**
+ * @brief 异步写入通道输入寄存器 (不更新输出)。
+ * @param hdac DAC8568设备句柄。
+ * @param channel 目标DAC通道 (CHANNEL_A 到 CHANNEL_H, 或 BROADCAST)。
+ * @param data 要写入的码值 (原生分辨率)。
+ * @retval HAL_OK 已启动 (结束时调用回调)；HAL_BUSY 设备或总线忙、复位恢复或最小更新间隔未结束，未发送；
+ *         HAL_ERROR 流式输出占用或启动失败。
+ * @note 与 DAC8568_Write 相同的命令帧，但不等待上一次传输。参考数据手册第35页表4。
+ *       返回 HAL_OK 或启动失败时都会调用一次回调；未关联DMA时发送完成后在返回前调用，
+ *       冗余帧被跳过时也立即调用 (status 为 HAL_OK)。
+ */
+HAL_StatusTypeDef DAC8568_Write_Async(DAC8568_HandleTypeDef *hdac, uint8_t channel, uint16_t data)
+{
+    HAL_StatusTypeDef status = DAC8568_TryAcquire(hdac);
+    if (status != HAL_OK)
+    {
+        return status;
+    }
+    uint32_t frame = DAC8568_EncodeCode(CMD_WRITE_INPUT_REG, channel, data);
+    return DAC8568_StartAsyncFrame(hdac, frame);
+}
+
+/**
+ * @brief 异步写入通道并立即更新其输出。
+ * @param hdac DAC8568设备句柄。
+ * @param channel 目标DAC通道 (CHANNEL_A 到 CHANNEL_H)。
+ * @param data 要写入的码值 (原生分辨率)。
+ * @retval 同 DAC8568_Write_Async。
+ * @note 控制环中可以在本帧发送期间计算下一个设定值。参考数据手册第37页表4。
+ */
+HAL_StatusTypeDef DAC8568_WriteAndUpdate_Async(DAC8568_HandleTypeDef *hdac, uint8_t channel, uint16_t data)
+{
+    HAL_StatusTypeDef status = DAC8568_TryAcquire(hdac);
+    if (status != HAL_OK)
+    {
+        return status;
+    }
+    uint32_t frame = DAC8568_EncodeCode(CMD_WRITE_INPUT_UPDATE_ONE, channel, data);
+    return DAC8568_StartAsyncFrame(hdac, frame);
+}
+
+/**
+ * @brief 异步写入全部8个通道并同时更新所有输出。
+ * @param hdac DAC8568设备句柄。
+ * @param data_array 通道A到H的码值 (原生分辨率)，函数返回后即可修改 (已编码到句柄的发送缓冲区)。
+ * @retval 同 DAC8568_Write_Async。
+ * @note 帧序列与 DAC8568_WriteAndUpdateAllChannels 相同，最后一帧同时更新8个输出。
+ */
+HAL_StatusTypeDef DAC8568_WriteAndUpdateAllChannels_Async(DAC8568_HandleTypeDef *hdac, const uint16_t *data_array)
+{
+    HAL_StatusTypeDef status = DAC8568_TryAcquire(hdac);
+    if (status != HAL_OK)
+    {
+        return status;
+    }
+    if (!DAC8568_TimingReady(hdac, 0xFF)) // 最后一帧更新全部通道
+    {
+        return HAL_BUSY;
+    }
+    uint8_t mask;
+    uint8_t count = DAC8568_EncodeAllChannels(hdac, data_array, CMD_WRITE_INPUT_UPDATE_ALL, &mask);
+    status = DAC8568_StartAsync(hdac, hdac->tx_buf, count);
+    DAC8568_Stamp(hdac, mask);
+    return status;
+}
+
+/**
+ * @brief 不等待地获取发送权，并按预编码帧更新影子寄存器。
+ * @param hdac DAC8568设备句柄。
+ * @param frames 线上顺序帧数组。
+ * @param count 帧数。
+ * @retval HAL_OK 可以发送；HAL_BUSY 设备或总线忙、复位恢复未结束；HAL_ERROR 流式输出占用中。
+ */
+static HAL_StatusTypeDef DAC8568_TryAcquireFrames(DAC8568_HandleTypeDef *hdac, const uint32_t *frames, uint16_t count)
+{
+    HAL_StatusTypeDef status = DAC8568_TryAcquire(hdac);
+    if (status != HAL_OK)
+    {
+        return status;
+    }
+    if (!DAC8568_TimingReady(hdac, 0))
+    {
+        return HAL_BUSY;
+    }
+    for (uint16_t i = 0; i < count; i++)
+    {
+        DAC8568_ShadowApply(&hdac->shadow, DAC8568_ToWire(hdac, frames[i])); // REV与半字交换均为自逆变换
+    }
+    return HAL_OK;
+}
+
+/**
+ * @brief 异步发送预编码的线上顺序帧。
+ * @param hdac DAC8568设备句柄。
+ * @param frames 线上顺序帧数组 (见 DAC8568_SendFrames)，回调之前不得修改或释放。
+ * @param count 帧数。
+ * @retval 同 DAC8568_Write_Async。
+ */
+HAL_StatusTypeDef DAC8568_SendFrames_Async(DAC8568_HandleTypeDef *hdac, const uint32_t *frames, uint16_t count)
+{
+    HAL_StatusTypeDef status = DAC8568_TryAcquireFrames(hdac, frames, count);
+    if (status != HAL_OK)
+    {
+        return status;
+    }
+    return DAC8568_StartAsync(hdac, frames, count);
+}
+
+/**
+ * @brief 不等待地发送预编码的线上顺序帧，不调用回调。
+ * @param hdac DAC8568设备句柄。
+ * @param frames 线上顺序帧数组 (见 DAC8568_SendFrames)，DAC8568_IsBusy 返回0之前不得修改或释放。
+ * @param count 帧数。
+ * @retval HAL_OK 已启动；HAL_BUSY 设备或总线忙、复位恢复未结束，未发送；HAL_ERROR 流式输出占用或启动失败。
+ * @note 供驱动内部的周期性发送 (如斜坡发生器) 使用: 不改变 DAC8568_GetLastStatus 的结果，
+ *       也不触发 DAC8568_RegisterCallback 注册的回调，应用程序的异步传输不受影响。
+ *       未关联DMA时在调用者上下文中阻塞发送。
+ */
+HAL_StatusTypeDef DAC8568_TrySendFrames(DAC8568_HandleTypeDef *hdac, const uint32_t *frames, uint16_t count)
+{
+    HAL_StatusTypeDef status = DAC8568_TryAcquireFrames(hdac, frames, count);
+    if (status != HAL_OK)
+    {
+        return status;
+    }
+    return DAC8568_TransmitBurst(hdac, frames, count);
+}
+
+/**
+ * @brief 查询最近一次异步传输的结果。
+ * @param hdac DAC8568设备句柄。
+ * @retval HAL_BUSY 传输进行中；HAL_OK 成功；HAL_ERROR/HAL_TIMEOUT 失败。
+ */
+HAL_StatusTypeDef DAC8568_GetLastStatus(DAC8568_HandleTypeDef *hdac)
+{
+    return hdac->last_status;
+}
+
+/**
+ * @brief 把一帧放入设备的命令队列，立即返回。
+ * @param hdac DAC8568设备句柄。
+ * @param frame 数值形式的帧 (由 DAC8568_EncodeFrame 或 DAC8568_FRAME 编码)。
+ * @retval 1 已入队 (或作为冗余帧跳过)，0 队列已满、设备被流式输出占用或处于软件复位恢复期内，帧被丢弃。
+ * @note 单生产者/单消费者无锁队列: 本函数只写 queue_head，传输完成回调只写 queue_tail，
+ *       先写入帧数据再发布 queue_head (__DMB保证顺序)。本函数不等待: 复位恢复期内直接返回0。
+ *       设备与总线空闲时本函数启动第一帧，之后由 DAC8568_TxCpltCallback 接连发送，
+ *       每帧的发送延迟不超过队列中排在它前面的帧数 × 单帧时间。
+ *       判断空闲并启动第一帧时短暂关中断 (一次DMA启动的时间)，使判断与占用总线不被同一总线上
+ *       其它设备的传输完成中断打断；总线已被占用时帧留在队列中，由该传输的完成回调发送。
+ *       使用限制:
+ *       1. 同一设备只能有一个生产者上下文 (主循环或某一个中断)，该上下文同时负责同一设备的其它驱动调用；
+ *       2. 在中断中入队时，该中断的优先级不能高于SPI发送DMA通道的中断优先级。
+ *       未关联DMA时在调用者上下文中立即阻塞发送 (队列中的帧逐个发送完才返回)；
+ *       总线正被另一上下文使用时不等待，帧留在队列中，下一次入队时发送。
+ *       队列中的帧背靠背发送，不受通道最小更新间隔限制。
+ */
+uint8_t DAC8568_Enqueue(DAC8568_HandleTypeDef *hdac, uint32_t frame)
+{
+    uint16_t head = hdac->queue_head;
+    if (hdac->streaming || (uint16_t)(head - hdac->queue_tail) >= DAC8568_QUEUE_SIZE)
+    {
+        hdac->queue_overflows++;
+        return 0;
+    }
+    if (!DAC8568_TimingReady(hdac, 0))
+    {
+        return 0; // 软件复位恢复期内不入队: 发布后传输完成回调随时可能发送该帧
+    }
+    if (!DAC8568_ShadowFilter(hdac, frame))
+    {
+        return 1;
+    }
+
+    hdac->queue[head & (DAC8568_QUEUE_SIZE - 1)] = DAC8568_ToWire(hdac, frame);
+    __DMB();                      // 帧数据写入完成后再发布
+    hdac->queue_head = head + 1U; // 发布: 此后消费者可以取走该帧
+
+#if DAC8568_USE_DMA
+    if (hdac->hspi->hdmatx != NULL)
+    {
+        // 设备忙时由传输完成回调接着发送；回调在发现队列为空之后才清除busy，不会漏掉刚入队的帧。
+        // 检查与占用之间不能被传输完成中断抢占，否则中断可能已启动本设备或同一总线上其它设备的队列
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        if (!hdac->busy && hdac->hspi->State == HAL_SPI_STATE_READY)
+        {
+            DAC8568_QueueStart(hdac); // 总线已被占用时帧留在队列中，由该传输的完成回调发送
+        }
+        __set_PRIMASK(primask);
+        return 1;
+    }
+#endif
+
+    if (hdac->hspi->State != HAL_SPI_STATE_READY)
+    {
+        return 1; // 阻塞模式: 总线被另一上下文的传输占用，帧留在队列中，下一次入队时发送
+    }
+    while (hdac->queue_tail != hdac->queue_head)
+    {
+        if (DAC8568_TransmitPolled(hdac, &hdac->queue[hdac->queue_tail & (DAC8568_QUEUE_SIZE - 1)], 1) != HAL_OK)
+        {
+            hdac->shadow.valid = 0; // 该帧未发出
+        }
+        hdac->queue_tail++;
+    }
+    return 1;
+}
+
+/**
+ * @brief 查询命令队列中尚未发送完成的帧数 (含正在发送的一帧)。
+ * @param hdac DAC8568设备句柄。
+ * @retval 帧数，0表示队列已清空。
+ */
+uint16_t DAC8568_GetQueueCount(DAC8568_HandleTypeDef *hdac)
+{
+    return (uint16_t)(hdac->queue_head - hdac->queue_tail);
+}
+
+/**
+ * @brief 获取设备的影子寄存器。
+ * @param hdac DAC8568设备句柄。
+ * @retval 影子寄存器指针，valid 为0时内容不保证与芯片一致。
+ */
+const DAC8568_ShadowTypeDef *DAC8568_GetShadow(DAC8568_HandleTypeDef *hdac)
+{
+    return &hdac->shadow;
+}
+
+/**
+ * @brief 查询通道输入寄存器的值。
+ * @param hdac DAC8568设备句柄。
+ * @param channel 通道 (CHANNEL_A 到 CHANNEL_H)。
+ * @retval 驱动最近写入该通道输入寄存器的码值 (原生分辨率)。
+ */
+uint16_t DAC8568_GetInputCode(DAC8568_HandleTypeDef *hdac, uint8_t channel)
+{
+    return DAC8568_DATA_TO_CODE(hdac->shadow.input_reg[channel & 0x07]);
+}
+
+/**
+ * @brief 查询通道DAC寄存器的值 (当前输出码)。
+ * @param hdac DAC8568设备句柄。
+ * @param channel 通道 (CHANNEL_A 到 CHANNEL_H)。
+ * @retval 该通道当前输出对应的码值 (原生分辨率)。
+ */
+uint16_t DAC8568_GetOutputCode(DAC8568_HandleTypeDef *hdac, uint8_t channel)
+{
+    return DAC8568_DATA_TO_CODE(hdac->shadow.dac_reg[channel & 0x07]);
+}
+
+/**
+ * @brief 查询通道电源模式。
+ * @param hdac DAC8568设备句柄。
+ * @param channel 通道 (CHANNEL_A 到 CHANNEL_H)。
+ * @retval POWER_UP, POWER_DOWN_1K, POWER_DOWN_100K 或 POWER_DOWN_HIZ。
+ */
+uint8_t DAC8568_GetPowerMode(DAC8568_HandleTypeDef *hdac, uint8_t channel)
+{
+    return hdac->shadow.power_mode[channel & 0x07];
+}
+
+/**
+ * @brief 查询LDAC寄存器。
+ * @param hdac DAC8568设备句柄。
+ * @retval 最近一次 DAC8568_SetLdacMask 设置的通道掩码 (软件复位后为0)。
+ */
+uint8_t DAC8568_GetLdacMask(DAC8568_HandleTypeDef *hdac)
+{
+    return hdac->shadow.ldac_mask;
+}
+
+/**
+ * @brief 声明影子寄存器与芯片状态不再一致。
+ * @param hdac DAC8568设备句柄。
+ * @note 在驱动之外改变芯片状态后调用 (流式输出、CLR引脚、硬件LDAC等)。
+ *       此后所有命令照常发送，直到下一次 DAC8568_SoftwareReset 使影子寄存器重新有效。
+ */
+void DAC8568_InvalidateShadow(DAC8568_HandleTypeDef *hdac)
+{
+    hdac->shadow.valid = 0;
+}
+
+/**
+ * @brief 设置或清除一条SPI总线上全部已注册设备的流式输出占用标志。
+ * @param hspi SPI句柄。
+ * @param streaming 1: 总线由流式输出引擎占用，各设备的普通命令直接丢弃；0: 释放。
+ * @note 由流式输出引擎在启动与停止时调用。引擎直接写SPI的DR，HAL的 hspi->State 不会改变，
+ *       只标记正在流式输出的设备时，同一总线上的其它设备仍会通过 DAC8568_Acquire 发送到流中。
+ */
+void DAC8568_SetBusStreaming(SPI_HandleTypeDef *hspi, uint8_t streaming)
+{
+    for (uint8_t i = 0; i < dac_handle_count; i++)
+    {
+        if (dac_handles[i]->hspi == hspi)
+        {
+            dac_handles[i]->streaming = streaming;
+        }
+    }
+}
+
+/**
+ * @brief 查询设备是否有DMA传输正在进行。
+ * @param hdac DAC8568设备句柄。
+ * @retval 1 表示上一帧仍在发送 (SYNC为低)，0 表示空闲。
+ * @note 阻塞模式下始终返回0。
+ */
+uint8_t DAC8568_IsBusy(DAC8568_HandleTypeDef *hdac)
+{
+    return hdac->busy;
+}
+
+/**
+ * @brief 等待设备当前的DMA传输完成。
+ * @param hdac DAC8568设备句柄。
+ * @note 在需要确认帧已经到达DAC的场合调用 (例如软件复位后计时、进入低功耗前)。
+ *       阻塞模式下立即返回。
+ */
+void DAC8568_WaitForTransfer(DAC8568_HandleTypeDef *hdac)
+{
+    while (hdac->busy)
+    {
+    }
+}
+
+/**
+ * @brief 查找在指定SPI总线上正在传输的设备。
+ * @param hspi SPI句柄。
+ * @retval 设备句柄，未找到时返回NULL。同一总线同一时刻只有一个设备在传输。
+ */
+static DAC8568_HandleTypeDef *DAC8568_FindActive(SPI_HandleTypeDef *hspi)
+{
+    for (uint8_t i = 0; i < dac_handle_count; i++)
+    {
+        if (dac_handles[i]->hspi == hspi && dac_handles[i]->busy)
+        {
+            return dac_handles[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief SPI发送完成回调处理，拉高对应设备的SYNC结束当前帧。
+ * @param hspi 触发回调的SPI句柄。
+ * @note 需在 HAL_SPI_TxCpltCallback 中调用 (见main.c)。
+ *       HAL在调用回调前已等待BSY清零，此时32位数据已全部移出，可以安全拉高SYNC。
+ */
+void DAC8568_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    DAC8568_HandleTypeDef *hdac = DAC8568_FindActive(hspi);
+    if (hdac == NULL)
+    {
+        return;
+    }
+
+    HAL_GPIO_WritePin(hdac->sync_port, hdac->sync_pin, GPIO_PIN_SET); // 拉高SYNC，结束当前帧
+    DAC8568_TRACE_END(hdac);
+#if DAC8568_USE_DMA
+    if (hdac->tx_remaining > 0)
+    {
+        // 连发: 立即启动下一帧 (GPIO两次写操作之间的SYNC高电平时间已满足数据手册要求)
+        hdac->tx_remaining--;
+        DAC8568_StartFrameDMA(hdac, hdac->tx_next++);
+        return;
+    }
+    if (hdac->tx_queued)
+    {
+        hdac->tx_queued = 0;
+        hdac->queue_tail++; // 该帧已发出，位置交还给生产者
+    }
+    hdac->busy = 0;
+    DAC8568_Complete(hdac, HAL_OK); // 异步传输: 调用用户回调 (回调中可以启动下一次传输)
+    DAC8568_QueueService(hspi); // 本设备或同一总线上其它设备的队列中还有帧时，立即发送下一帧
+#else
+    hdac->busy = 0;
+#endif
+}
+
+/**
+ * @brief SPI传输错误回调处理，拉高对应设备的SYNC并释放驱动。
+ * @param hspi 触发回调的SPI句柄。
+ * @note 需在 HAL_SPI_ErrorCallback 中调用 (见main.c)。SYNC提前拉高会使DAC丢弃该帧，
+ *       连发中尚未发送的帧也一并放弃；命令队列只丢弃出错的一帧。
+ */
+void DAC8568_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+    DAC8568_HandleTypeDef *hdac = DAC8568_FindActive(hspi);
+    if (hdac != NULL)
+    {
+        HAL_GPIO_WritePin(hdac->sync_port, hdac->sync_pin, GPIO_PIN_SET);
+        DAC8568_TRACE_END(hdac);
+        hdac->tx_remaining = 0; // 放弃剩余的连发帧
+        if (hdac->tx_queued)
+        {
+            hdac->tx_queued = 0;
+            hdac->queue_tail++; // 放弃出错的队列帧，队列中其余的帧继续发送
+        }
+        hdac->busy = 0;
+        DAC8568_Complete(hdac, HAL_ERROR);
+#if DAC8568_USE_DMA
+        DAC8568_QueueService(hspi);
+#endif
+    }
+}
+
+#if DAC8568_TRACE
+/**
+ * @brief 清空跟踪记录与统计。
+ * @param hdac DAC8568设备句柄。
+ * @note 由 DAC8568_Init 调用。应在设备空闲时调用 (DMA传输中清空会使正在进行的事务计入新的统计)。
+ */
+void DAC8568_Trace_Reset(DAC8568_HandleTypeDef *hdac)
+{
+    DAC8568_TraceTypeDef *t = &hdac->trace;
+    t->head = 0;
+    for (uint8_t cmd = 0; cmd < DAC8568_TRACE_CMDS; cmd++)
+    {
+        t->count[cmd] = 0;
+        t->sum[cmd] = 0;
+        t->min[cmd] = UINT32_MAX;
+        t->max[cmd] = 0;
+        t->max_start[cmd] = 0;
+    }
+}
+
+/**
+ * @brief 读取按命令分类的耗时统计。
+ * @param hdac DAC8568设备句柄。
+ * @param stats 输出: DAC8568_TRACE_CMDS 个元素，下标为命令位 (如 CMD_WRITE_INPUT_UPDATE_ONE)。
+ * @note 统计自上一次 DAC8568_Trace_Reset 起累计，不受环形缓冲区覆盖的影响。
+ *       每个命令一次64位除法，只在读取时计算；读取期间完成的事务可能只计入部分字段。
+ */
+void DAC8568_Trace_GetStats(DAC8568_HandleTypeDef *hdac, DAC8568_TraceStatsTypeDef stats[DAC8568_TRACE_CMDS])
+{
+    const DAC8568_TraceTypeDef *t = &hdac->trace;
+    for (uint8_t cmd = 0; cmd < DAC8568_TRACE_CMDS; cmd++)
+    {
+        uint32_t count = t->count[cmd];
+        stats[cmd].count = count;
+        stats[cmd].min = count ? t->min[cmd] : 0;
+        stats[cmd].avg = count ? (uint32_t)(t->sum[cmd] / count) : 0;
+        stats[cmd].max = t->max[cmd];
+        stats[cmd].max_start = t->max_start[cmd];
+    }
+}
+
+/**
+ * @brief 按时间顺序读出最近的跟踪记录。
+ * @param hdac DAC8568设备句柄。
+ * @param records 输出缓冲区。
+ * @param max 最多读出的记录数。
+ * @retval 读出的记录数 (不超过 DAC8568_TRACE_SIZE)，records[0] 最早。
+ * @note 应在设备空闲时读取，否则最早的记录可能在复制过程中被覆盖。
+ */
+uint16_t DAC8568_Trace_Read(DAC8568_HandleTypeDef *hdac, DAC8568_TraceRecordTypeDef *records, uint16_t max)
+{
+    const DAC8568_TraceTypeDef *t = &hdac->trace;
+    uint32_t head = t->head;
+    uint32_t n = (head < DAC8568_TRACE_SIZE) ? head : DAC8568_TRACE_SIZE;
+    if (n > max)
+    {
+        n = max;
+    }
+    for (uint32_t k = 0; k < n; k++)
+    {
+        records[k] = t->ring[(head - n + k) & (DAC8568_TRACE_SIZE - 1)];
+    }
+    return (uint16_t)n;
+}
+#endif
@@ -0,0 +1,225 @@
+/*
+ * DAC8568 驱动性能测试
+ * 作者: 雪豹
+ */
+#include "DAC8568_Bench.h"
+#include "DAC8568_Cal.h"
+#include <stdio.h>
+
+// 测试用数据，DMA传输期间必须保持有效
+static uint16_t bench_data[8] = {0x1000, 0x3000, 0x5000, 0x7000, 0x9000, 0xB000, 0xD000, 0xF000};
+static uint16_t bench_samples[64];
+static uint32_t bench_frames[64];
+static uint8_t bench_raw[4] = {0x03, 0x08, 0x00, 0x00}; // 写入并更新通道A，数据0x8000
+static DAC8568_CalTypeDef bench_cal;
+
+/**
+ * @brief 使能DWT周期计数器。
+ * @note Cortex-M3的DWT->CYCCNT以HCLK计数，32位在72MHz下约59秒回绕，单项测试远小于此。
+ */
+void DAC8568_Bench_EnableCycleCounter(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief 计算SPI每个位占用的CPU周期数。
+ * @param hdac DAC8568设备句柄。
+ * @retval HCLK周期数。SPI1位于APB2，SPI2位于APB1，波特率 = PCLK / 2^(BR+1)。
+ */
+uint32_t DAC8568_Bench_GetBitCycles(const DAC8568_HandleTypeDef *hdac)
+{
+    uint32_t pclk = (hdac->hspi->Instance == SPI1) ? HAL_RCC_GetPCLK2Freq() : HAL_RCC_GetPCLK1Freq();
+    uint32_t div = 2U << (hdac->hspi->Init.BaudRatePrescaler >> 3);
+    return div * (HAL_RCC_GetHCLKFreq() / pclk);
+}
+
+/**
+ * @brief 调用一次指定的测试项。
+ * @param hdac DAC8568设备句柄。
+ * @param index 测试项编号 (与 bench_items 对应)。
+ * @param i 循环序号，用作写入数据。
+ */
+static void DAC8568_Bench_Call(DAC8568_HandleTypeDef *hdac, uint8_t index, uint32_t i)
+{
+    switch (index)
+    {
+    case 0:
+        DAC8568_Write(hdac, CHANNEL_A, (uint16_t)i);
+        break;
+    case 1:
+        DAC8568_Update(hdac, CHANNEL_A);
+        break;
+    case 2:
+        DAC8568_WriteAndUpdate(hdac, CHANNEL_A, (uint16_t)i);
+        break;
+    case 3:
+        DAC8568_WriteAllChannels(hdac, bench_data);
+        break;
+    case 4:
+        DAC8568_WriteAndUpdateAllChannels(hdac, bench_data);
+        break;
+    case 5:
+        DAC8568_UpdateAllChannels(hdac);
+        break;
+    case 6:
+        DAC8568_SetPowerMode(hdac, BROADCAST, POWER_UP);
+        break;
+    case 7:
+        DAC8568_SetClearCode(hdac, CLEAR_CODE_ZERO_SCALE);
+        break;
+    case 8:
+        DAC8568_SendRawCommand(hdac, CMD_WRITE_INPUT_UPDATE_ONE, CHANNEL_A, (uint16_t)i, 0);
+        break;
+    case 9:
+        DAC8568_SendRawData(hdac, bench_raw);
+        break;
+    case 10:
+        DAC8568_SendFrames(hdac, bench_frames, 64);
+        break;
+    case 11:
+        while (!DAC8568_Enqueue(hdac, DAC8568_CODE_FRAME(CMD_WRITE_INPUT_UPDATE_ONE, CHANNEL_A, i)))
+        {
+            // 队列已满: 等待传输完成回调腾出位置
+        }
+        break;
+    case 12:
+        while (DAC8568_WriteAndUpdate_Async(hdac, CHANNEL_A, (uint16_t)i) == HAL_BUSY)
+        {
+            // 上一帧仍在发送
+        }
+        break;
+    case 13:
+        DAC8568_Cal_WriteAndUpdate(hdac, &bench_cal, CHANNEL_A, (uint16_t)i);
+        break;
+    case 14:
+        DAC8568_Cal_WriteAndUpdateAllChannels(hdac, &bench_cal, bench_data);
+        break;
+    default:
+        DAC8568_WriteAndUpdate(hdac, CHANNEL_A, 0x8000); // 设定值不变，由影子寄存器跳过
+        break;
+    }
+}
+
+// 测试项名称与每次调用发送的帧数
+static const struct
+{
+    const char *name;
+    uint8_t frames;
+} bench_items[DAC8568_BENCH_COUNT] = {
+    {"Write", 1},
+    {"Update", 1},
+    {"WriteAndUpdate", 1},
+    {"WriteAllChannels", 8},
+    {"WriteAndUpdateAllChannels", 8},
+    {"UpdateAllChannels", 1},
+    {"SetPowerMode", 1},
+    {"SetClearCode", 1},
+    {"SendRawCommand", 1},
+    {"SendRawData", 1},
+    {"SendFrames(64)", 64},
+    {"Enqueue", 1},
+    {"WriteAndUpdate_Async", 1},
+    {"Cal_WriteAndUpdate", 1},
+    {"Cal_WriteAndUpdateAll", 8},
+    {"WriteAndUpdate(same)", 0},
+};
+
+/**
+ * @brief 依次测量所有驱动入口函数。
+ * @param hdac DAC8568设备句柄 (已初始化)。
+ * @param results 结果数组，至少 DAC8568_BENCH_COUNT 个元素。
+ * @retval 测试项数量。
+ * @note 软件复位与参考电压命令未列入: 前者包含固定延时，后者与 SendRawCommand 路径相同。
+ *       除最后一项外测试期间关闭冗余跳过 (skip_redundant = 0)，保证每次调用都产生SPI帧；
+ *       最后一项重复写入相同设定值，测量影子寄存器跳过冗余帧的开销。
+ */
+uint8_t DAC8568_Bench_Run(DAC8568_HandleTypeDef *hdac, DAC8568_BenchResultTypeDef *results)
+{
+    uint32_t bit_cycles = DAC8568_Bench_GetBitCycles(hdac);
+    uint32_t hclk = HAL_RCC_GetHCLKFreq();
+
+    for (uint16_t i = 0; i < 64; i++)
+    {
+        bench_samples[i] = (uint16_t)(i << 10);
+    }
+    DAC8568_EncodeFrames(hdac, bench_frames, CMD_WRITE_INPUT_UPDATE_ONE, CHANNEL_A, bench_samples, 64);
+    DAC8568_Cal_Init(&bench_cal);
+    DAC8568_Cal_Set(&bench_cal, BROADCAST, 65000, -3 * DAC8568_CAL_ONE); // 典型的小幅修正
+
+    DAC8568_Bench_EnableCycleCounter();
+    DAC8568_WaitForTransfer(hdac);
+
+    uint8_t skip_redundant = hdac->skip_redundant;
+    for (uint8_t n = 0; n < DAC8568_BENCH_COUNT; n++)
+    {
+        DAC8568_BenchResultTypeDef *r = &results[n];
+        hdac->skip_redundant = (bench_items[n].frames == 0);
+        uint32_t start = DWT->CYCCNT;
+        for (uint32_t i = 0; i < DAC8568_BENCH_ITERATIONS; i++)
+        {
+            DAC8568_Bench_Call(hdac, n, i);
+        }
+        DAC8568_WaitForTransfer(hdac); // DMA模式下计入最后一次传输
+        uint32_t cycles = DWT->CYCCNT - start;
+
+        r->name = bench_items[n].name;
+        r->calls = DAC8568_BENCH_ITERATIONS;
+        r->frames = DAC8568_BENCH_ITERATIONS * bench_items[n].frames;
+        r->cycles = cycles;
+        r->cycles_per_call = cycles / r->calls;
+        r->cycles_per_frame = r->frames ? cycles / r->frames : 0;
+        r->frames_per_sec = (uint32_t)((uint64_t)r->frames * hclk / (cycles ? cycles : 1));
+        r->bus_permille = (uint32_t)((uint64_t)r->frames * 32U * bit_cycles * 1000U / (cycles ? cycles : 1));
+    }
+    hdac->skip_redundant = skip_redundant;
+    return DAC8568_BENCH_COUNT;
+}
+
+/**
+ * @brief 通过printf输出测试结果表格。
+ * @param results 结果数组。
+ * @param count 结果数量。
+ */
+void DAC8568_Bench_Print(const DAC8568_BenchResultTypeDef *results, uint8_t count)
+{
+    printf("backend: %s\n", (DAC8568_BACKEND == DAC8568_BACKEND_REG) ? "REG" : "HAL"); // 结果只对应编译进来的阻塞后端
+    printf("%-26s %10s %10s %10s %8s\n", "entry", "cyc/call", "cyc/frame", "frames/s", "bus");
+    for (uint8_t n = 0; n < count; n++)
+    {
+        const DAC8568_BenchResultTypeDef *r = &results[n];
+        printf("%-26s %10lu %10lu %10lu %6lu.%lu%%\n", r->name, (unsigned long)r->cycles_per_call,
+               (unsigned long)r->cycles_per_frame, (unsigned long)r->frames_per_sec,
+               (unsigned long)(r->bus_permille / 10U), (unsigned long)(r->bus_permille % 10U));
+    }
+}
+
+#if DAC8568_TRACE
+/**
+ * @brief 通过printf输出SPI事务跟踪的统计表格 (按命令分类，只列出出现过的命令)。
+ * @param hdac DAC8568设备句柄 (DAC8568_TRACE 为1)。
+ * @note 耗时为SYNC拉低到拉高的HCLK周期数，max_at 为最大耗时那一帧的开始时刻 (DWT->CYCCNT)。
+ */
+void DAC8568_Bench_PrintTrace(DAC8568_HandleTypeDef *hdac)
+{
+    static const char *const names[DAC8568_TRACE_CMDS] = {
+        "write_input", "update_dac", "write_update_all", "write_update_one",
+        "power_down", "clear_code", "ldac_reg", "software_reset",
+        "internal_ref", "cmd_9", "cmd_10", "cmd_11", "cmd_12", "cmd_13", "cmd_14", "cmd_15"};
+    DAC8568_TraceStatsTypeDef stats[DAC8568_TRACE_CMDS];
+
+    DAC8568_Trace_GetStats(hdac, stats);
+    printf("%-18s %8s %8s %8s %8s %10s\n", "cmd", "count", "min", "avg", "max", "max_at");
+    for (uint8_t cmd = 0; cmd < DAC8568_TRACE_CMDS; cmd++)
+    {
+        const DAC8568_TraceStatsTypeDef *s = &stats[cmd];
+        if (s->count != 0)
+        {
+            printf("%-18s %8lu %8lu %8lu %8lu %10lu\n", names[cmd], (unsigned long)s->count, (unsigned long)s->min,
+                   (unsigned long)s->avg, (unsigned long)s->max, (unsigned long)s->max_start);
+        }
+    }
+}
+#endif
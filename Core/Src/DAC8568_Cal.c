@@ -0,0 +1,136 @@
+/*
+ * DAC8568 通道校准 (增益/失调，Q16定点)
+ * 作者: 雪豹
+ */
+#include "DAC8568_Cal.h"
+
+/**
+ * @brief 初始化校准表为不修正 (gain = 1.0，offset = 0)。
+ * @param cal 校准表。
+ */
+void DAC8568_Cal_Init(DAC8568_CalTypeDef *cal)
+{
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        cal->ch[i].gain = DAC8568_CAL_ONE;
+        cal->ch[i].offset = 0;
+    }
+}
+
+/**
+ * @brief 设置通道的校准系数。
+ * @param cal 校准表。
+ * @param channel 通道 (CHANNEL_A 到 CHANNEL_H) 或 BROADCAST (全部通道)。
+ * @param gain Q16增益，65536 = 1.0。
+ * @param offset Q16失调，65536 = 1个LSB。
+ */
+void DAC8568_Cal_Set(DAC8568_CalTypeDef *cal, uint8_t channel, int32_t gain, int32_t offset)
+{
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        if (channel == BROADCAST || i == (channel & 0x07))
+        {
+            cal->ch[i].gain = gain;
+            cal->ch[i].offset = offset;
+        }
+    }
+}
+
+/**
+ * @brief 由两点测量结果计算通道的校准系数。
+ * @param cal 校准表。
+ * @param channel 通道 (CHANNEL_A 到 CHANNEL_H)。
+ * @param code1 第一个测量点写入的码值 (未校准)。
+ * @param actual1 第一个测量点实际输出对应的码值。
+ * @param code2 第二个测量点写入的码值，应与 code1 相距较远 (如满量程的10%与90%)。
+ * @param actual2 第二个测量点实际输出对应的码值。
+ * @note 实际输出 = a × 码值 + b，修正后写入 (目标 - actual1) / a + code1，即
+ *       gain = (code2 - code1) / (actual2 - actual1)，offset = code1 - gain × actual1。
+ *       actual1 与 actual2 相等时保持原系数不变。
+ */
+void DAC8568_Cal_TwoPoint(DAC8568_CalTypeDef *cal, uint8_t channel, uint16_t code1, uint16_t actual1,
+                          uint16_t code2, uint16_t actual2)
+{
+    int32_t span = (int32_t)actual2 - (int32_t)actual1;
+    if (span == 0)
+    {
+        return;
+    }
+    int64_t gain = ((int64_t)((int32_t)code2 - (int32_t)code1) << 16) / span;
+    int64_t offset = ((int64_t)code1 << 16) - gain * actual1;
+    cal->ch[channel & 0x07].gain = (int32_t)gain;
+    cal->ch[channel & 0x07].offset = (int32_t)offset;
+}
+
+/**
+ * @brief 一次修正8个通道的码值。
+ * @param cal 校准表。
+ * @param in 通道A到H的目标码值。
+ * @param out 输出: 修正后的码值，可以与 in 相同。
+ */
+void DAC8568_Cal_ApplyAll(const DAC8568_CalTypeDef *cal, const uint16_t *in, uint16_t *out)
+{
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        out[i] = DAC8568_Cal_Apply(&cal->ch[i], in[i]);
+    }
+}
+
+/**
+ * @brief 校准后写入通道输入寄存器。
+ * @param hdac DAC8568设备句柄。
+ * @param cal 校准表。
+ * @param channel 通道 (CHANNEL_A 到 CHANNEL_H) 或 BROADCAST。
+ * @param code 目标码值 (原生分辨率)。
+ * @note BROADCAST 时各通道系数不同，展开为8通道写入 (DAC8568_WriteAllChannels)。
+ */
+void DAC8568_Cal_Write(DAC8568_HandleTypeDef *hdac, const DAC8568_CalTypeDef *cal, uint8_t channel, uint16_t code)
+{
+    if (channel == BROADCAST)
+    {
+        uint16_t data[8];
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            data[i] = DAC8568_Cal_Apply(&cal->ch[i], code);
+        }
+        DAC8568_WriteAllChannels(hdac, data);
+        return;
+    }
+    DAC8568_Write(hdac, channel, DAC8568_Cal_Apply(&cal->ch[channel & 0x07], code));
+}
+
+/**
+ * @brief 校准后写入通道并更新输出。
+ * @param hdac DAC8568设备句柄。
+ * @param cal 校准表。
+ * @param channel 通道 (CHANNEL_A 到 CHANNEL_H) 或 BROADCAST。
+ * @param code 目标码值 (原生分辨率)。
+ * @note BROADCAST 时展开为8通道写入并同时更新 (DAC8568_WriteAndUpdateAllChannels)。
+ */
+void DAC8568_Cal_WriteAndUpdate(DAC8568_HandleTypeDef *hdac, const DAC8568_CalTypeDef *cal, uint8_t channel, uint16_t code)
+{
+    if (channel == BROADCAST)
+    {
+        uint16_t data[8];
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            data[i] = DAC8568_Cal_Apply(&cal->ch[i], code);
+        }
+        DAC8568_WriteAndUpdateAllChannels(hdac, data);
+        return;
+    }
+    DAC8568_WriteAndUpdate(hdac, channel, DAC8568_Cal_Apply(&cal->ch[channel & 0x07], code));
+}
+
+/**
+ * @brief 校准后写入全部8个通道并同时更新输出。
+ * @param hdac DAC8568设备句柄。
+ * @param cal 校准表。
+ * @param data 通道A到H的目标码值，不会被修改。
+ */
+void DAC8568_Cal_WriteAndUpdateAllChannels(DAC8568_HandleTypeDef *hdac, const DAC8568_CalTypeDef *cal, const uint16_t *data)
+{
+    uint16_t corrected[8];
+    DAC8568_Cal_ApplyAll(cal, data, corrected);
+    DAC8568_WriteAndUpdateAllChannels(hdac, corrected); // 编码到句柄的发送缓冲区，局部数组可以立即释放
+}
@@ -0,0 +1,281 @@
+/*
+ * DAC8568 直接数字频率合成 (DDS) 引擎
+ * 作者: 雪豹
+ */
+#include "DAC8568_DDS.h"
+#include "DAC8568_Stream.h"
+
+// 一个完整周期的Q15正弦表，sin(2πi/512)×32767
+static const int16_t dds_sine[DAC8568_DDS_SINE_SIZE] = {
+    0, 402, 804, 1206, 1608, 2009, 2410, 2811, 3212, 3612, 4011, 4410,
+    4808, 5205, 5602, 5998, 6393, 6786, 7179, 7571, 7962, 8351, 8739, 9126,
+    9512, 9896, 10278, 10659, 11039, 11417, 11793, 12167, 12539, 12910, 13279, 13645,
+    14010, 14372, 14732, 15090, 15446, 15800, 16151, 16499, 16846, 17189, 17530, 17869,
+    18204, 18537, 18868, 19195, 19519, 19841, 20159, 20475, 20787, 21096, 21403, 21705,
+    22005, 22301, 22594, 22884, 23170, 23452, 23731, 24007, 24279, 24547, 24811, 25072,
+    25329, 25582, 25832, 26077, 26319, 26556, 26790, 27019, 27245, 27466, 27683, 27896,
+    28105, 28310, 28510, 28706, 28898, 29085, 29268, 29447, 29621, 29791, 29956, 30117,
+    30273, 30424, 30571, 30714, 30852, 30985, 31113, 31237, 31356, 31470, 31580, 31685,
+    31785, 31880, 31971, 32057, 32137, 32213, 32285, 32351, 32412, 32469, 32521, 32567,
+    32609, 32646, 32678, 32705, 32728, 32745, 32757, 32765, 32767, 32765, 32757, 32745,
+    32728, 32705, 32678, 32646, 32609, 32567, 32521, 32469, 32412, 32351, 32285, 32213,
+    32137, 32057, 31971, 31880, 31785, 31685, 31580, 31470, 31356, 31237, 31113, 30985,
+    30852, 30714, 30571, 30424, 30273, 30117, 29956, 29791, 29621, 29447, 29268, 29085,
+    28898, 28706, 28510, 28310, 28105, 27896, 27683, 27466, 27245, 27019, 26790, 26556,
+    26319, 26077, 25832, 25582, 25329, 25072, 24811, 24547, 24279, 24007, 23731, 23452,
+    23170, 22884, 22594, 22301, 22005, 21705, 21403, 21096, 20787, 20475, 20159, 19841,
+    19519, 19195, 18868, 18537, 18204, 17869, 17530, 17189, 16846, 16499, 16151, 15800,
+    15446, 15090, 14732, 14372, 14010, 13645, 13279, 12910, 12539, 12167, 11793, 11417,
+    11039, 10659, 10278, 9896, 9512, 9126, 8739, 8351, 7962, 7571, 7179, 6786,
+    6393, 5998, 5602, 5205, 4808, 4410, 4011, 3612, 3212, 2811, 2410, 2009,
+    1608, 1206, 804, 402, 0, -402, -804, -1206, -1608, -2009, -2410, -2811,
+    -3212, -3612, -4011, -4410, -4808, -5205, -5602, -5998, -6393, -6786, -7179, -7571,
+    -7962, -8351, -8739, -9126, -9512, -9896, -10278, -10659, -11039, -11417, -11793, -12167,
+    -12539, -12910, -13279, -13645, -14010, -14372, -14732, -15090, -15446, -15800, -16151, -16499,
+    -16846, -17189, -17530, -17869, -18204, -18537, -18868, -19195, -19519, -19841, -20159, -20475,
+    -20787, -21096, -21403, -21705, -22005, -22301, -22594, -22884, -23170, -23452, -23731, -24007,
+    -24279, -24547, -24811, -25072, -25329, -25582, -25832, -26077, -26319, -26556, -26790, -27019,
+    -27245, -27466, -27683, -27896, -28105, -28310, -28510, -28706, -28898, -29085, -29268, -29447,
+    -29621, -29791, -29956, -30117, -30273, -30424, -30571, -30714, -30852, -30985, -31113, -31237,
+    -31356, -31470, -31580, -31685, -31785, -31880, -31971, -32057, -32137, -32213, -32285, -32351,
+    -32412, -32469, -32521, -32567, -32609, -32646, -32678, -32705, -32728, -32745, -32757, -32765,
+    -32767, -32765, -32757, -32745, -32728, -32705, -32678, -32646, -32609, -32567, -32521, -32469,
+    -32412, -32351, -32285, -32213, -32137, -32057, -31971, -31880, -31785, -31685, -31580, -31470,
+    -31356, -31237, -31113, -30985, -30852, -30714, -30571, -30424, -30273, -30117, -29956, -29791,
+    -29621, -29447, -29268, -29085, -28898, -28706, -28510, -28310, -28105, -27896, -27683, -27466,
+    -27245, -27019, -26790, -26556, -26319, -26077, -25832, -25582, -25329, -25072, -24811, -24547,
+    -24279, -24007, -23731, -23452, -23170, -22884, -22594, -22301, -22005, -21705, -21403, -21096,
+    -20787, -20475, -20159, -19841, -19519, -19195, -18868, -18537, -18204, -17869, -17530, -17189,
+    -16846, -16499, -16151, -15800, -15446, -15090, -14732, -14372, -14010, -13645, -13279, -12910,
+    -12539, -12167, -11793, -11417, -11039, -10659, -10278, -9896, -9512, -9126, -8739, -8351,
+    -7962, -7571, -7179, -6786, -6393, -5998, -5602, -5205, -4808, -4410, -4011, -3612,
+    -3212, -2811, -2410, -2009, -1608, -1206, -804, -402,
+};
+
+/**
+ * @brief 初始化DDS引擎，所有通道关闭、相位清零。
+ * @param dds DDS引擎。
+ */
+void DAC8568_DDS_Init(DAC8568_DDS_HandleTypeDef *dds)
+{
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        dds->ch[i].phase = 0;
+        dds->ch[i].tuning = 0;
+        dds->ch[i].amplitude = 0;
+        dds->ch[i].offset = 0x8000;
+        dds->ch[i].wave = DAC8568_DDS_OFF;
+        dds->ch[i].table_bits = 0;
+        dds->ch[i].table = NULL;
+    }
+    dds->active = 0;
+    dds->slot = 0;
+    dds->update_cmd = CMD_WRITE_INPUT_UPDATE_ALL;
+}
+
+/**
+ * @brief 由输出频率计算频率控制字。
+ * @param freq_mhz 输出频率，单位毫赫兹 (mHz)，例如1kHz传入1000000。
+ * @param sample_rate 每个通道的采样率 (Hz)。
+ * @retval 频率控制字 = freq × 2^32 / sample_rate。
+ * @note 只在设置参数时调用，包含一次64位除法，不在采样路径中使用。
+ */
+uint32_t DAC8568_DDS_TuningWord(uint32_t freq_mhz, uint32_t sample_rate)
+{
+    return (uint32_t)((((uint64_t)freq_mhz << 32) / 1000U) / sample_rate);
+}
+
+/**
+ * @brief 重新生成已启用通道的发送顺序。
+ */
+static void DAC8568_DDS_UpdateOrder(DAC8568_DDS_HandleTypeDef *dds)
+{
+    dds->active = 0;
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        if (dds->ch[i].wave != DAC8568_DDS_OFF)
+        {
+            dds->order[dds->active++] = i;
+        }
+    }
+    dds->slot = 0;
+}
+
+/**
+ * @brief 配置一个通道的振荡器。
+ * @param dds DDS引擎。
+ * @param channel 通道 (CHANNEL_A 到 CHANNEL_H)。
+ * @param wave 波形，DAC8568_DDS_OFF 关闭该通道。
+ * @param tuning 频率控制字 (见 DAC8568_DDS_TuningWord)。
+ * @param amplitude 峰值幅度 (码值，0~32767)。
+ * @param offset 中心码值 (如0x8000)。
+ * @note 相位不清零，运行中修改频率或幅度时波形连续。
+ */
+void DAC8568_DDS_SetChannel(DAC8568_DDS_HandleTypeDef *dds, uint8_t channel, DAC8568_DDS_WaveTypeDef wave,
+                            uint32_t tuning, uint16_t amplitude, uint16_t offset)
+{
+    DAC8568_DDS_ChannelTypeDef *osc = &dds->ch[channel & 0x07];
+    uint8_t was_on = (osc->wave != DAC8568_DDS_OFF);
+
+    osc->tuning = tuning;
+    osc->amplitude = (amplitude > 32767U) ? 32767U : amplitude;
+    osc->offset = offset;
+    osc->wave = (uint8_t)wave;
+    if (was_on != (wave != DAC8568_DDS_OFF))
+    {
+        DAC8568_DDS_UpdateOrder(dds);
+    }
+}
+
+/**
+ * @brief 为通道指定用户波形表 (波形类型需为 DAC8568_DDS_TABLE)。
+ * @param dds DDS引擎。
+ * @param channel 通道。
+ * @param table Q15波形表，一个周期，点数为2^table_bits，输出期间必须保持有效。
+ * @param table_bits 表点数的log2 (1~16)。
+ * @note table_bits 超出范围时不使用该表 (通道输出 offset)，避免采样中断里移位32位及以上。
+ */
+void DAC8568_DDS_SetTable(DAC8568_DDS_HandleTypeDef *dds, uint8_t channel, const int16_t *table, uint8_t table_bits)
+{
+    uint8_t valid = (table_bits >= 1U && table_bits <= 16U);
+    dds->ch[channel & 0x07].table = valid ? table : NULL;
+    dds->ch[channel & 0x07].table_bits = valid ? table_bits : 0;
+}
+
+/**
+ * @brief 设置通道的相位，用于多通道之间的相位对齐 (如正交信号相差0x40000000)。
+ * @param dds DDS引擎。
+ * @param channel 通道。
+ * @param phase 32位相位，2^32对应一个周期。
+ */
+void DAC8568_DDS_SetPhase(DAC8568_DDS_HandleTypeDef *dds, uint8_t channel, uint32_t phase)
+{
+    dds->ch[channel & 0x07].phase = phase;
+}
+
+/**
+ * @brief 在2^bits点的Q15表中按相位线性插值。
+ * @param table 波形表。
+ * @param bits 表点数的log2。
+ * @param phase 32位相位。
+ * @retval Q15样本。
+ */
+static inline int32_t DAC8568_DDS_Lookup(const int16_t *table, uint8_t bits, uint32_t phase)
+{
+    uint32_t index = phase >> (32U - bits);
+    uint32_t frac = (phase << bits) >> 17; // 两点之间的位置，15位小数
+    int32_t a = table[index];
+    int32_t b = table[(index + 1U) & ((1U << bits) - 1U)];
+    return a + (((b - a) * (int32_t)frac) >> 15); // |b - a| ≤ 65535，乘积小于2^31，不会溢出
+}
+
+/**
+ * @brief 计算一个通道当前相位的输出码并推进相位。
+ * @param osc 通道振荡器。
+ * @retval 16位输出码。
+ */
+uint16_t DAC8568_DDS_Sample(DAC8568_DDS_ChannelTypeDef *osc)
+{
+    uint32_t phase = osc->phase;
+    int32_t s;
+
+    osc->phase = phase + osc->tuning;
+    switch (osc->wave)
+    {
+    case DAC8568_DDS_SINE:
+        s = DAC8568_DDS_Lookup(dds_sine, DAC8568_DDS_SINE_BITS, phase);
+        break;
+    case DAC8568_DDS_TRIANGLE: // 前半周期上升，后半周期下降
+        s = (int32_t)(((phase & 0x80000000U) ? ~phase : phase) >> 15) - 32768;
+        break;
+    case DAC8568_DDS_SAW:
+        s = (int32_t)(phase >> 16) - 32768;
+        break;
+    case DAC8568_DDS_SQUARE:
+        s = (phase & 0x80000000U) ? -32767 : 32767;
+        break;
+    case DAC8568_DDS_TABLE:
+        s = (osc->table != NULL) ? DAC8568_DDS_Lookup(osc->table, osc->table_bits, phase) : 0;
+        break;
+    default:
+        return osc->offset;
+    }
+
+    int32_t code = (int32_t)osc->offset + ((s * (int32_t)osc->amplitude) >> 15);
+    if (code < 0)
+    {
+        code = 0;
+    }
+    else if (code > 0xFFFF)
+    {
+        code = 0xFFFF;
+    }
+    return (uint16_t)code;
+}
+
+/**
+ * @brief 所有通道前进一个采样。
+ * @param dds DDS引擎。
+ * @param codes 输出: 8个通道的原生分辨率码值 (按 DAC8568_DEVICE 由16位样本右移)，关闭的通道为其中心码值。
+ * @note 供定时器中断使用，例如:
+ *       DAC8568_DDS_Step(&dds, codes);
+ *       if (!DAC8568_IsBusy(&hdac1)) DAC8568_WriteAndUpdateAllChannels(&hdac1, codes);
+ *       codes 在DMA连发期间不被读取 (驱动已复制到句柄的发送缓冲区)。
+ */
+void DAC8568_DDS_Step(DAC8568_DDS_HandleTypeDef *dds, uint16_t codes[8])
+{
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        codes[i] = DAC8568_DATA_TO_CODE(DAC8568_DDS_Sample(&dds->ch[i]));
+    }
+}
+
+/**
+ * @brief 选择流式帧的更新方式。
+ * @param dds DDS引擎。
+ * @param enable 1: 所有帧只写输入寄存器，由定时LDAC脉冲更新 (DAC8568_Stream_SetLdacStrobe)；
+ *               0: 每组最后一帧用 CMD_WRITE_INPUT_UPDATE_ALL 更新 (默认)。
+ */
+void DAC8568_DDS_SetLdacStrobe(DAC8568_DDS_HandleTypeDef *dds, uint8_t enable)
+{
+    dds->update_cmd = enable ? CMD_WRITE_INPUT_REG : CMD_WRITE_INPUT_UPDATE_ALL;
+}
+
+/**
+ * @brief 生成流式输出帧。
+ * @param dds DDS引擎。
+ * @param frames 输出缓冲区 (流式帧格式)。
+ * @param count 帧数，不必是启用通道数的整数倍，下一次调用从中断处继续。
+ * @note 帧中直接使用16位样本作为数据位，低分辨率型号忽略多余的低位，不需要转换。
+ *       已启用通道按A到H的顺序轮流输出一帧，每组最后一帧用 CMD_WRITE_INPUT_UPDATE_ALL
+ *       同时更新整组 (定时LDAC时由LDAC脉冲更新)；每通道采样率 = 帧速率 / 启用通道数。没有启用的通道时不修改缓冲区。
+ */
+void DAC8568_DDS_Render(DAC8568_DDS_HandleTypeDef *dds, uint32_t *frames, uint16_t count)
+{
+    if (dds->active == 0)
+    {
+        return;
+    }
+    uint8_t slot = dds->slot;
+    uint8_t last = dds->active - 1U;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        uint8_t ch = dds->order[slot];
+        uint16_t code = DAC8568_DDS_Sample(&dds->ch[ch]);
+        uint8_t cmd = (slot == last) ? dds->update_cmd : CMD_WRITE_INPUT_REG;
+        frames[i] = DAC8568_STREAM_FRAME(cmd, ch, code, 0);
+        slot = (slot == last) ? 0 : slot + 1U;
+    }
+    dds->slot = slot;
+}
+
+/**
+ * @brief 乒乓流式输出的生成函数 (DAC8568_Stream_StartPingPong)。
+ * @param context DDS引擎 (DAC8568_DDS_HandleTypeDef *)。
+ * @param frames 待填充的半个缓冲区。
+ * @param count 帧数。
+ */
+void DAC8568_DDS_Generator(void *context, uint32_t *frames, uint16_t count)
+{
+    DAC8568_DDS_Render((DAC8568_DDS_HandleTypeDef *)context, frames, count);
+}
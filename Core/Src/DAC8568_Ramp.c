@@ -0,0 +1,216 @@
+/*
+ * DAC8568 斜率限制斜坡发生器
+ * 作者: 雪豹
+ */
+#include "DAC8568_Ramp.h"
+
+/**
+ * @brief 码值转换为Q16位置，超出满量程时饱和。
+ * @param code 码值 (原生分辨率)。
+ * @retval Q16位置。
+ */
+static inline uint32_t DAC8568_Ramp_ToQ16(uint16_t code)
+{
+    uint32_t c = code;
+    return ((c > DAC8568_MAX_CODE) ? DAC8568_MAX_CODE : c) << 16;
+}
+
+/**
+ * @brief 初始化斜坡发生器，各通道以影子寄存器中的当前输出为起点，全部静止。
+ * @param ramp 斜坡发生器。
+ * @param hdac DAC8568设备句柄 (已执行 DAC8568_Init)。
+ * @note 影子寄存器无效时 (如流式输出之后) 起点未必是实际输出，应再用 DAC8568_Ramp_SetPosition 指定。
+ */
+void DAC8568_Ramp_Init(DAC8568_RampTypeDef *ramp, DAC8568_HandleTypeDef *hdac)
+{
+    ramp->hdac = hdac;
+    ramp->late_ticks = 0;
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        ramp->ch[i].rate = 0;
+        DAC8568_Ramp_SetPosition(ramp, i, DAC8568_GetOutputCode(hdac, i));
+    }
+}
+
+/**
+ * @brief 指定通道的当前位置并停止运动，不发送帧。
+ * @param ramp 斜坡发生器。
+ * @param channel 通道 (CHANNEL_A 到 CHANNEL_H)。
+ * @param code 当前输出码值 (原生分辨率)。
+ * @note 用于与驱动之外写入的输出同步；不要在该通道运动期间于主循环中调用。
+ */
+void DAC8568_Ramp_SetPosition(DAC8568_RampTypeDef *ramp, uint8_t channel, uint16_t code)
+{
+    DAC8568_Ramp_ChannelTypeDef *c = &ramp->ch[channel & 0x07];
+    c->code = code;
+    c->position = DAC8568_Ramp_ToQ16(code);
+    c->target = c->position;
+}
+
+/**
+ * @brief 设定通道的目标码值与斜率，之后每个节拍前进一步直到到达目标。
+ * @param ramp 斜坡发生器。
+ * @param channel 通道 (CHANNEL_A 到 CHANNEL_H) 或 BROADCAST (全部通道)。
+ * @param code 目标码值 (原生分辨率)，超出满量程时饱和。
+ * @param rate 斜率 (Q16码值/节拍，见 DAC8568_RAMP_RATE)，0表示下一节拍直接跳到目标。
+ * @note 运动中可以随时修改目标与斜率，从当前位置继续，不会产生跳变。
+ */
+void DAC8568_Ramp_SetTarget(DAC8568_RampTypeDef *ramp, uint8_t channel, uint16_t code, uint32_t rate)
+{
+    uint32_t target = DAC8568_Ramp_ToQ16(code);
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        if (channel == BROADCAST || i == (channel & 0x07))
+        {
+            ramp->ch[i].rate = rate;
+            ramp->ch[i].target = target; // 最后写入目标，节拍中断读到新目标时斜率已经有效
+        }
+    }
+}
+
+/**
+ * @brief 设定通道的目标码值，斜率取为在指定节拍数内到达。
+ * @param ramp 斜坡发生器。
+ * @param channel 通道 (CHANNEL_A 到 CHANNEL_H) 或 BROADCAST (每个通道按各自的距离计算斜率)。
+ * @param code 目标码值 (原生分辨率)。
+ * @param ticks 节拍数，0表示下一节拍直接跳到目标。
+ * @note 斜率向上取整，到达时间不超过 ticks 个节拍；多个通道用相同的 ticks 即可同时到达。
+ *       每个通道一次除法，只在设定时计算。
+ */
+void DAC8568_Ramp_SetTargetIn(DAC8568_RampTypeDef *ramp, uint8_t channel, uint16_t code, uint32_t ticks)
+{
+    uint32_t target = DAC8568_Ramp_ToQ16(code);
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        if (channel == BROADCAST || i == (channel & 0x07))
+        {
+            uint32_t position = ramp->ch[i].position;
+            uint32_t distance = (target > position) ? target - position : position - target;
+            uint32_t rate = (ticks == 0) ? 0 : distance / ticks + ((distance % ticks) != 0);
+            DAC8568_Ramp_SetTarget(ramp, i, code, (rate == 0 && ticks != 0) ? 1U : rate);
+        }
+    }
+}
+
+/**
+ * @brief 通道停在当前位置。
+ * @param ramp 斜坡发生器。
+ * @param channel 通道 (CHANNEL_A 到 CHANNEL_H) 或 BROADCAST (全部通道)。
+ */
+void DAC8568_Ramp_Stop(DAC8568_RampTypeDef *ramp, uint8_t channel)
+{
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        if (channel == BROADCAST || i == (channel & 0x07))
+        {
+            ramp->ch[i].target = ramp->ch[i].position;
+        }
+    }
+}
+
+/**
+ * @brief 斜坡节拍，在定时器中断中以固定周期调用。
+ * @param ramp 斜坡发生器。
+ * @retval HAL_OK 已发出本节拍的帧或没有需要发送的帧；
+ *         HAL_BUSY 上一次连发尚未结束或总线被占用，本节拍顺延 (位置不前进)；
+ *         HAL_ERROR 设备被流式输出占用。
+ * @note 只为码值有变化的通道编码，最多8帧放在一次DMA连发中背靠背发送，函数不等待传输结束。
+ *       节拍周期应大于8帧的发送时间 (SPI1 18MHz时约16μs)。
+ *       连发经 DAC8568_TrySendFrames 启动，不触发 DAC8568_RegisterCallback 注册的回调。
+ *       SPI未关联DMA (或 DAC8568_USE_DMA 为0) 时在本函数内阻塞发送，
+ *       在定时器中断中调用会占用中断最多8帧的发送时间加HAL开销，这种配置应在主循环中调用。
+ */
+HAL_StatusTypeDef DAC8568_Ramp_Tick(DAC8568_RampTypeDef *ramp)
+{
+    DAC8568_HandleTypeDef *hdac = ramp->hdac;
+    uint32_t next[8];
+    uint32_t encoded[8]; // 数值形式的帧，转换为线上顺序后存入 ramp->frames
+    uint16_t codes[8];
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        DAC8568_Ramp_ChannelTypeDef *c = &ramp->ch[i];
+        uint32_t position = c->position;
+        uint32_t target = c->target; // 只读一次，主循环可能同时修改
+        uint32_t rate = c->rate;
+        if (rate == 0)
+        {
+            position = target;
+        }
+        else if (position < target)
+        {
+            position = (target - position > rate) ? position + rate : target;
+        }
+        else
+        {
+            position = (position - target > rate) ? position - rate : target;
+        }
+        next[i] = position;
+        codes[i] = (uint16_t)((position + 0x8000U) >> 16); // 四舍五入，最大为 DAC8568_MAX_CODE
+        if (codes[i] != c->code)
+        {
+            encoded[count++] = DAC8568_CODE_FRAME(CMD_WRITE_INPUT_REG, i, codes[i]);
+        }
+    }
+
+    if (count != 0)
+    {
+        if (hdac->streaming)
+        {
+            return HAL_ERROR;
+        }
+        if (DAC8568_IsBusy(hdac))
+        {
+            ramp->late_ticks++; // 上一次连发仍在读取 ramp->frames
+            return HAL_BUSY;
+        }
+        encoded[count - 1U] |= DAC8568_FRAME(CMD_WRITE_INPUT_UPDATE_ALL, 0, 0, 0); // 0000 -> 0010，同时更新
+        for (uint8_t k = 0; k < count; k++)
+        {
+            ramp->frames[k] = hdac->spi16 ? DAC8568_FrameToHalfWords(encoded[k]) : DAC8568_FrameToWire(encoded[k]);
+        }
+        HAL_StatusTypeDef status = DAC8568_TrySendFrames(hdac, ramp->frames, count);
+        if (status != HAL_OK)
+        {
+            ramp->late_ticks += (status == HAL_BUSY);
+            return status;
+        }
+    }
+
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        ramp->ch[i].position = next[i];
+        ramp->ch[i].code = codes[i];
+    }
+    return HAL_OK;
+}
+
+/**
+ * @brief 查询仍在运动的通道。
+ * @param ramp 斜坡发生器。
+ * @retval 通道掩码，bit0对应通道A；0表示全部已到达目标。
+ */
+uint8_t DAC8568_Ramp_GetMoving(const DAC8568_RampTypeDef *ramp)
+{
+    uint8_t mask = 0;
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        if (ramp->ch[i].position != ramp->ch[i].target)
+        {
+            mask |= (uint8_t)(1U << i);
+        }
+    }
+    return mask;
+}
+
+/**
+ * @brief 查询通道最近一次发送的码值。
+ * @param ramp 斜坡发生器。
+ * @param channel 通道 (CHANNEL_A 到 CHANNEL_H)。
+ * @retval 码值 (原生分辨率)。
+ */
+uint16_t DAC8568_Ramp_GetCode(const DAC8568_RampTypeDef *ramp, uint8_t channel)
+{
+    return ramp->ch[channel & 0x07].code;
+}
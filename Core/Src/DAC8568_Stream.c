@@ -0,0 +1,454 @@
+/*
+ * DAC8568 硬件定时流式输出引擎
+ * 作者: 雪豹
+ */
+#include "DAC8568_Stream.h"
+
+// SYNC引脚的BSRR写入值，DMA以循环模式反复搬运这两个常量
+static uint32_t sync_low_word;  // 高16位复位位: 拉低SYNC
+static uint32_t sync_high_word; // 低16位置位位: 拉高SYNC
+
+static DAC8568_HandleTypeDef *stream_dac; // 正在流式输出的设备，NULL表示未运行
+static uint32_t saved_spi_cr1;   // 进入流式输出前的SPI1 CR1
+static uint32_t saved_spi_cr2;   // 进入流式输出前的SPI1 CR2
+static uint32_t saved_dma_ccr;   // 进入流式输出前的DMA1通道3 CCR (HAL配置)
+
+// 乒乓缓冲
+static DAC8568_Stream_GeneratorTypeDef stream_generator; // NULL表示普通循环播放
+static void *stream_context;
+static uint32_t *stream_frames;          // 循环缓冲区
+static uint16_t stream_half;             // 半个缓冲区的帧数
+static volatile uint32_t stream_underruns; // 欠载次数
+static uint32_t stream_refill_max;       // 最长一次填充的CPU周期数 (DWT->CYCCNT)
+static uint32_t stream_refill_budget;    // 半个缓冲区的播放时长 (CPU周期)
+
+// 定时LDAC
+static uint8_t stream_ldac_group;        // 每次LDAC脉冲对应的帧数，0表示不使用
+static uint8_t stream_ldac_active;       // 1: 本次输出由TIM4驱动LDAC引脚
+
+/**
+ * @brief 获取TIM3的计数时钟频率。
+ * @retval TIM3时钟频率 (Hz)。APB1分频不为1时定时器时钟为PCLK1的2倍。
+ */
+static uint32_t DAC8568_Stream_GetTimerClock(void)
+{
+    uint32_t pclk1 = HAL_RCC_GetPCLK1Freq();
+    return ((RCC->CFGR & RCC_CFGR_PPRE1) == RCC_CFGR_PPRE1_DIV1) ? pclk1 : 2U * pclk1;
+}
+
+/**
+ * @brief 计算发送一个32位帧所需的定时器时钟周期数。
+ * @retval 32个SCLK对应的TIM3时钟周期数。
+ * @note SPI1位于APB2，波特率 = PCLK2 / 2^(BR+1)。
+ */
+static uint32_t DAC8568_Stream_GetFrameTicks(void)
+{
+    uint32_t spi_div = 2U << ((SPI1->CR1 & SPI_CR1_BR) >> SPI_CR1_BR_Pos);
+    uint64_t ticks = (uint64_t)32U * spi_div * DAC8568_Stream_GetTimerClock() / HAL_RCC_GetPCLK2Freq();
+    return (uint32_t)ticks;
+}
+
+/**
+ * @brief 获取当前时钟配置下可达到的最高帧速率。
+ * @retval 最高帧速率 (帧/秒)。八通道轮流输出时每通道采样率为该值的1/8。
+ */
+uint32_t DAC8568_Stream_GetMaxFrameRate(void)
+{
+    uint32_t min_period = DAC8568_Stream_GetFrameTicks() + DAC8568_STREAM_DMA_MARGIN +
+                          DAC8568_STREAM_SYNC_HIGH_MIN + DAC8568_STREAM_SYNC_LEAD;
+    return DAC8568_Stream_GetTimerClock() / min_period;
+}
+
+/**
+ * @brief 配置一个DMA1通道为内存到外设的循环传输。
+ * @param ch DMA通道寄存器。
+ * @param periph 外设寄存器地址。
+ * @param mem 内存地址。
+ * @param count 循环传输的数据个数。
+ * @param ccr 除EN外的通道配置位。
+ */
+static void DAC8568_Stream_SetupChannel(DMA_Channel_TypeDef *ch, volatile void *periph, const void *mem,
+                                        uint16_t count, uint32_t ccr)
+{
+    ch->CCR = 0;
+    ch->CPAR = (uint32_t)periph;
+    ch->CMAR = (uint32_t)mem;
+    ch->CNDTR = count;
+    ch->CCR = ccr | DMA_CCR_DIR | DMA_CCR_CIRC;
+}
+
+/**
+ * @brief 配置TIM4_CH1在每组帧之后输出LDAC低脉冲，由TIM3启动时同步触发。
+ * @param psc TIM3的预分频值 (TIM4使用相同的计数时钟)。
+ * @param arr TIM3的自动重装载值。
+ * @note TIM3从 sync_high + 1 开始计数，第k帧的输入寄存器在 arr + k × (arr + 1) 时刻之前锁存，
+ *       组内最后一帧 (k = group - 1) 即在 group × (arr + 1) - 1 之前。TIM4的周期为 group × (arr + 1)，
+ *       回绕后 CNT < CCR1 的 width 个计数内LDAC为低。TIM4从 width 开始计数，第一个周期的ARR加长
+ *       (见 DAC8568_Stream_LdacFirstReload)，使第一次回绕在第一组最后一帧锁存之后 delay 个计数，
+ *       之后ARR经预装载恢复为整组周期；第一组帧发出之前不会有LDAC脉冲锁存旧的输入寄存器。
+ *       脉冲结束时下一组的第一帧还没有移位完成，输入寄存器尚未被覆盖。
+ */
+static void DAC8568_Stream_SetupLdacTimer(uint32_t psc, uint32_t arr)
+{
+    uint32_t group_ticks = stream_ldac_group * (arr + 1U);
+    uint32_t delay = DAC8568_STREAM_LDAC_DELAY / (psc + 1U) + 2U; // 含TIM4触发同步的延迟
+    uint32_t width = DAC8568_STREAM_LDAC_WIDTH / (psc + 1U) + 1U;
+    uint32_t cnt;
+    uint32_t first_arr = DAC8568_Stream_LdacFirstReload(group_ticks, delay, width, &cnt);
+
+    __HAL_RCC_TIM4_CLK_ENABLE();
+    TIM4->CR1 = TIM_CR1_ARPE; // ARR预装载: 第一个周期加长，回绕时切换为整组周期
+    TIM4->SMCR = 0;
+    TIM4->DIER = 0;
+    TIM4->PSC = psc;
+    TIM4->ARR = first_arr;
+    TIM4->CCR1 = width;
+    TIM4->CCMR1 = TIM_CCMR1_OC1M_2;             // 强制无效电平，切换引脚时LDAC保持高电平
+    TIM4->CCER = TIM_CCER_CC1P | TIM_CCER_CC1E; // 低电平有效
+    TIM4->EGR = TIM_EGR_UG;                     // 装载预分频值与第一个周期的ARR
+    TIM4->ARR = group_ticks - 1U;               // 进入预装载寄存器，第一次回绕时生效
+    TIM4->SR = 0;
+    TIM4->CNT = cnt;
+
+    // LDAC引脚切换为TIM4_CH1复用推挽输出
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+    GPIO_InitStruct.Pin = DAC8568_STREAM_LDAC_PIN;
+    GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(DAC8568_STREAM_LDAC_PORT, &GPIO_InitStruct);
+
+    TIM4->CCMR1 = TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1PE; // PWM模式1
+    TIM4->SMCR = TIM_SMCR_TS_1 | TIM_SMCR_SMS_2 | TIM_SMCR_SMS_1;       // 触发模式，ITR2 = TIM3
+    TIM3->CR2 = TIM_CR2_MMS_0;                                          // TRGO = CEN，与TIM3同时开始计数
+    stream_ldac_active = 1;
+}
+
+/**
+ * @brief 配置并启动TIM3与三个DMA通道。
+ * @param hdac DAC8568设备句柄。
+ * @param frames 帧缓冲区。
+ * @param count 帧数。
+ * @param frame_rate 帧速率 (帧/秒)。
+ * @param irq DMA1通道3额外使能的中断 (DMA_CCR_HTIE | DMA_CCR_TCIE，或0)。
+ * @retval HAL_OK 启动成功；HAL_ERROR 参数无效；HAL_BUSY 已在运行。
+ */
+static HAL_StatusTypeDef DAC8568_Stream_Begin(DAC8568_HandleTypeDef *hdac, const uint32_t *frames, uint16_t count,
+                                              uint32_t frame_rate, uint32_t irq)
+{
+    if (stream_dac != NULL)
+    {
+        return HAL_BUSY;
+    }
+    if (hdac->hspi->Instance != SPI1 || frames == NULL || count == 0 || count > 0x7FFF || frame_rate == 0)
+    {
+        return HAL_ERROR;
+    }
+    uint32_t span = (stream_ldac_group != 0) ? stream_ldac_group : 1U;
+    if (stream_ldac_group != 0 &&
+        (hdac->ldac_port != DAC8568_STREAM_LDAC_PORT || hdac->ldac_pin != DAC8568_STREAM_LDAC_PIN || count % span != 0))
+    {
+        return HAL_ERROR; // LDAC必须接在TIM4_CH1 (PB6)，缓冲区必须是整数组
+    }
+
+    // 计算定时器周期，超过16位时使用预分频 (定时LDAC时TIM4的一个周期为整组帧，按整组计算)
+    uint32_t period = DAC8568_Stream_GetTimerClock() / frame_rate;
+    uint32_t limit = (stream_ldac_group != 0) ? 0x10000U - DAC8568_STREAM_LDAC_HEADROOM : 0x10000U;
+    uint32_t psc = (period * span) / limit;
+    uint32_t arr = period / (psc + 1U) - 1U;
+
+    // 帧内事件位置 (换算为预分频后的计数值，至少1个计数)
+    uint32_t lead = DAC8568_STREAM_SYNC_LEAD / (psc + 1U) + 1U;
+    uint32_t lo_offset = DAC8568_STREAM_LO_OFFSET / (psc + 1U) + 1U;
+    uint32_t sync_high = (DAC8568_Stream_GetFrameTicks() + DAC8568_STREAM_DMA_MARGIN) / (psc + 1U) + 1U;
+    if (sync_high + DAC8568_STREAM_SYNC_HIGH_MIN / (psc + 1U) + lead + 1U > arr)
+    {
+        return HAL_ERROR; // 帧速率过高，一个周期内无法完成32位传输
+    }
+
+    if (stream_ldac_group != 0)
+    {
+        DAC8568_SetLdacMask(hdac, 0); // 所有通道等待LDAC脉冲
+    }
+    DAC8568_WaitForTransfer(hdac);                 // 等待普通DMA发送结束，释放SPI1与DMA1通道3
+    DAC8568_SetBusStreaming(hdac->hspi, 1);        // 此后SPI1上所有设备的普通命令都被丢弃，命令队列不再启动
+    while (hdac->hspi->State != HAL_SPI_STATE_READY)
+    {
+        // 同一总线上的其它设备正在完成已启动的传输
+    }
+    hdac->hspi->State = HAL_SPI_STATE_BUSY_TX; // 引擎直接写DR，HAL状态不会改变: 标记总线忙，直接调用HAL的代码得到HAL_BUSY
+    DAC8568_InvalidateShadow(hdac); // 流式帧直接由DMA发出，影子寄存器无法跟踪
+
+    sync_low_word = (uint32_t)hdac->sync_pin << 16;
+    sync_high_word = hdac->sync_pin;
+    hdac->sync_port->BSRR = sync_high_word;
+
+    // SPI1切换为16位数据帧，关闭SPI自身的DMA请求 (由定时器节拍写DR)
+    saved_spi_cr1 = SPI1->CR1;
+    saved_spi_cr2 = SPI1->CR2;
+    SPI1->CR1 &= ~SPI_CR1_SPE;
+    SPI1->CR2 &= ~(SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN);
+    SPI1->CR1 |= SPI_CR1_DFF;
+    SPI1->CR1 |= SPI_CR1_SPE;
+
+    // DMA1通道3: 帧数据 -> SPI1->DR (16位，内存递增)
+    __HAL_RCC_DMA1_CLK_ENABLE();
+    saved_dma_ccr = DMA1_Channel3->CCR & ~DMA_CCR_EN;
+    DAC8568_Stream_SetupChannel(DMA1_Channel3, &SPI1->DR, frames, (uint16_t)(count * 2U),
+                                DMA_CCR_MINC | DMA_CCR_PSIZE_0 | DMA_CCR_MSIZE_0 | DMA_CCR_PL | irq);
+    // DMA1通道6: SYNC拉低；DMA1通道2: SYNC拉高 (32位，地址不递增)
+    DAC8568_Stream_SetupChannel(DMA1_Channel6, &hdac->sync_port->BSRR, &sync_low_word, 1,
+                                DMA_CCR_PSIZE_1 | DMA_CCR_MSIZE_1 | DMA_CCR_PL_1);
+    DAC8568_Stream_SetupChannel(DMA1_Channel2, &hdac->sync_port->BSRR, &sync_high_word, 1,
+                                DMA_CCR_PSIZE_1 | DMA_CCR_MSIZE_1 | DMA_CCR_PL_1);
+    DMA1->IFCR = DMA_IFCR_CGIF2 | DMA_IFCR_CGIF3 | DMA_IFCR_CGIF6;
+    DMA1_Channel2->CCR |= DMA_CCR_EN;
+    DMA1_Channel3->CCR |= DMA_CCR_EN;
+    DMA1_Channel6->CCR |= DMA_CCR_EN;
+
+    // TIM3: 输出比较冻结模式，仅利用比较事件产生DMA请求
+    __HAL_RCC_TIM3_CLK_ENABLE();
+    TIM3->CR1 = 0;
+    TIM3->CR2 = 0;
+    TIM3->DIER = 0;
+    TIM3->CCMR1 = 0;
+    TIM3->CCMR2 = 0;
+    TIM3->CCER = 0;
+    TIM3->PSC = psc;
+    TIM3->ARR = arr;
+    TIM3->CCR1 = arr - lead;
+    TIM3->CCR3 = sync_high;
+    TIM3->CCR4 = lo_offset;
+    TIM3->EGR = TIM_EGR_UG; // 装载预分频值 (此时DMA请求尚未使能)
+    TIM3->SR = 0;
+    TIM3->CNT = sync_high + 1U; // 从SYNC高电平区间开始，保证第一个DMA事件是拉低SYNC，半字不会错位
+    TIM3->DIER = TIM_DIER_UDE | TIM_DIER_CC1DE | TIM_DIER_CC3DE | TIM_DIER_CC4DE;
+    if (stream_ldac_group != 0)
+    {
+        DAC8568_Stream_SetupLdacTimer(psc, arr);
+    }
+
+    stream_dac = hdac;
+    TIM3->CR1 = TIM_CR1_CEN; // 先到达CC1拉低SYNC，随后的更新事件发出第一帧
+    return HAL_OK;
+}
+
+/**
+ * @brief 启动硬件定时流式输出。
+ * @param hdac DAC8568设备句柄，必须挂在SPI1上 (TIM3与DMA1通道2/3/6的请求映射固定)。
+ * @param frames 预编码帧缓冲区 (每个元素用 DAC8568_STREAM_FRAME 构造)，输出期间必须保持有效，
+ *               可由应用程序在输出过程中修改内容。
+ * @param count 缓冲区中的帧数 (1 ~ 32767)，缓冲区循环播放。
+ * @param frame_rate 帧速率 (帧/秒)，不得超过 DAC8568_Stream_GetMaxFrameRate()。
+ * @retval HAL_OK 启动成功；HAL_ERROR 参数无效；HAL_BUSY 已在运行。
+ * @note 采样间隔由TIM3产生，每帧的SYNC拉低/拉高和两个半字的写入全部由DMA完成，
+ *       CPU不参与每个采样。调用前需已执行 DAC8568_Init，SPI1由驱动临时切换为16位模式。
+ */
+HAL_StatusTypeDef DAC8568_Stream_Start(DAC8568_HandleTypeDef *hdac, const uint32_t *frames, uint16_t count, uint32_t frame_rate)
+{
+    return DAC8568_Stream_Begin(hdac, frames, count, frame_rate, 0); // stream_generator 在停止时已清除
+}
+
+/**
+ * @brief 以乒乓缓冲方式启动流式输出，半个缓冲区播放完时由生成函数填充。
+ * @param hdac DAC8568设备句柄，必须挂在SPI1上。
+ * @param frames 循环缓冲区 (RAM)，输出期间必须保持有效。
+ * @param count 缓冲区帧数，偶数 (2 ~ 32766)。
+ * @param frame_rate 帧速率 (帧/秒)。
+ * @param generator 生成函数，在DMA1通道3中断中调用，每次生成 count/2 帧。
+ * @param context 传给生成函数的参数 (如 DDS 引擎或波形解码器)。
+ * @retval HAL_OK 启动成功；HAL_ERROR 参数无效；HAL_BUSY 已在运行。
+ * @note 启动前先调用生成函数填满整个缓冲区。每次填充的时间预算为半个缓冲区的播放时长，
+ *       缓冲区越大，中断越少，对生成函数耗时抖动的容忍度越高。
+ */
+HAL_StatusTypeDef DAC8568_Stream_StartPingPong(DAC8568_HandleTypeDef *hdac, uint32_t *frames, uint16_t count, uint32_t frame_rate,
+                                               DAC8568_Stream_GeneratorTypeDef generator, void *context)
+{
+    if (stream_dac != NULL)
+    {
+        return HAL_BUSY; // 缓冲区可能正在播放，不能预先填充
+    }
+    if (generator == NULL || frames == NULL || count < 2 || (count & 1U) || frame_rate == 0)
+    {
+        return HAL_ERROR;
+    }
+
+    stream_generator = generator;
+    stream_context = context;
+    stream_frames = frames;
+    stream_half = count / 2U;
+    stream_underruns = 0;
+    stream_refill_max = 0;
+    stream_refill_budget = (uint32_t)((uint64_t)stream_half * HAL_RCC_GetHCLKFreq() / frame_rate);
+    generator(context, frames, count);
+
+    HAL_StatusTypeDef status = DAC8568_Stream_Begin(hdac, frames, count, frame_rate, DMA_CCR_HTIE | DMA_CCR_TCIE);
+    if (status != HAL_OK)
+    {
+        stream_generator = NULL;
+    }
+    return status;
+}
+
+/**
+ * @brief 乒乓缓冲的DMA中断处理，在 DMA1_Channel3_IRQHandler 的开头调用。
+ * @retval 1 已处理 (乒乓输出运行中)，调用者直接返回；0 交给 HAL_DMA_IRQHandler 处理普通发送。
+ * @note HT表示DMA已进入后半 (填充前半)，TC表示DMA已回到前半 (填充后半)。以下情况计为欠载:
+ *       HT与TC同时挂起 (漏掉了一次中断)；进入中断时DMA已经回到待填充的一半；
+ *       填充结束时DMA已经回到刚填充的一半 (生成函数超出预算)。
+ */
+uint8_t DAC8568_Stream_IRQHandler(void)
+{
+    if (stream_dac == NULL || stream_generator == NULL)
+    {
+        return 0;
+    }
+
+    uint32_t isr = DMA1->ISR;
+    DMA1->IFCR = DMA_IFCR_CGIF3;
+    if (!(isr & (DMA_ISR_HTIF3 | DMA_ISR_TCIF3)))
+    {
+        return 1;
+    }
+
+    uint32_t start = DWT->CYCCNT;
+    uint32_t half_words = 2U * stream_half; // CNDTR以半字计数
+    uint8_t fill_second;
+    if ((isr & DMA_ISR_HTIF3) && (isr & DMA_ISR_TCIF3))
+    {
+        stream_underruns++;
+        fill_second = (DMA1_Channel3->CNDTR > half_words); // 按DMA当前位置填充另一半
+    }
+    else
+    {
+        fill_second = (isr & DMA_ISR_TCIF3) != 0;
+        if ((DMA1_Channel3->CNDTR > half_words) != fill_second)
+        {
+            stream_underruns++; // 中断响应过晚
+        }
+    }
+
+    stream_generator(stream_context, stream_frames + (fill_second ? stream_half : 0U), stream_half);
+
+    if ((DMA1_Channel3->CNDTR > half_words) != fill_second)
+    {
+        stream_underruns++; // 填充期间DMA已回到这一半
+    }
+    uint32_t elapsed = DWT->CYCCNT - start;
+    if (elapsed > stream_refill_max)
+    {
+        stream_refill_max = elapsed;
+    }
+    return 1;
+}
+
+/**
+ * @brief 查询乒乓输出的欠载次数。
+ * @retval 自 DAC8568_Stream_StartPingPong 以来的欠载次数。
+ */
+uint32_t DAC8568_Stream_GetUnderruns(void)
+{
+    return stream_underruns;
+}
+
+/**
+ * @brief 查询生成函数最长一次填充的耗时。
+ * @retval CPU周期数 (DWT->CYCCNT)，包含中断处理本身。
+ */
+uint32_t DAC8568_Stream_GetRefillCycles(void)
+{
+    return stream_refill_max;
+}
+
+/**
+ * @brief 查询每次填充的时间预算。
+ * @retval 半个缓冲区的播放时长 (CPU周期)，减去中断响应时间后即生成函数的可用时间。
+ */
+uint32_t DAC8568_Stream_GetRefillBudget(void)
+{
+    return stream_refill_budget;
+}
+
+/**
+ * @brief 停止流式输出，恢复SPI1与DMA1通道3的原有配置。
+ * @note 若停止时正处于帧传输中，SYNC被提前拉高，DAC会丢弃该不完整的帧。
+ */
+void DAC8568_Stream_Stop(void)
+{
+    if (stream_dac == NULL)
+    {
+        return;
+    }
+
+    TIM3->CR1 = 0;
+    TIM3->DIER = 0;
+    TIM3->CR2 = 0;
+    if (stream_ldac_active)
+    {
+        // 停止TIM4，LDAC引脚恢复为空闲高电平的推挽输出
+        TIM4->CR1 = 0;
+        TIM4->SMCR = 0;
+        TIM4->CCER = 0;
+        GPIO_InitTypeDef GPIO_InitStruct = {0};
+        HAL_GPIO_WritePin(DAC8568_STREAM_LDAC_PORT, DAC8568_STREAM_LDAC_PIN, GPIO_PIN_SET);
+        GPIO_InitStruct.Pin = DAC8568_STREAM_LDAC_PIN;
+        GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+        GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+        HAL_GPIO_Init(DAC8568_STREAM_LDAC_PORT, &GPIO_InitStruct);
+        stream_ldac_active = 0;
+    }
+    DMA1_Channel2->CCR = 0;
+    DMA1_Channel6->CCR = 0;
+    DMA1_Channel3->CCR = 0;
+    DMA1->IFCR = DMA_IFCR_CGIF2 | DMA_IFCR_CGIF3 | DMA_IFCR_CGIF6;
+
+    // 等待最后一个半字移出后再恢复SPI配置
+    while (SPI1->SR & SPI_SR_BSY)
+    {
+    }
+    stream_dac->sync_port->BSRR = sync_high_word;
+
+    SPI1->CR1 &= ~SPI_CR1_SPE;
+    SPI1->CR2 = saved_spi_cr2;
+    SPI1->CR1 = saved_spi_cr1;
+    (void)SPI1->DR; // 清除全双工模式下接收端的溢出标志
+    (void)SPI1->SR;
+    DMA1_Channel3->CCR = saved_dma_ccr;
+
+    stream_dac->hspi->State = HAL_SPI_STATE_READY;
+    DAC8568_SetBusStreaming(stream_dac->hspi, 0);
+    stream_dac = NULL;
+    stream_generator = NULL;
+}
+
+/**
+ * @brief 设置定时LDAC: 之后启动的流式输出由TIM4_CH1在每 group 帧之后输出一个LDAC脉冲。
+ * @param group 每次LDAC脉冲对应的帧数 (1 ~ 8，通常等于轮流输出的通道数)，0表示不使用。
+ * @retval HAL_OK 成功；HAL_ERROR 参数无效；HAL_BUSY 流式输出正在运行。
+ * @note 帧中只能使用 CMD_WRITE_INPUT_REG (DAC8568_DDS_SetLdacStrobe / DAC8568_Wave_SetLdacStrobe)，
+ *       输出时刻只由TIM4决定，SPI移位与DMA仲裁的延迟不会出现在输出上。
+ *       启动时要求设备已用 DAC8568_AttachLdacPin 连接PB6，驱动会把LDAC寄存器清零；
+ *       输出期间PB6由TIM4驱动，DAC8568_PulseLdac 无效，停止后恢复为GPIO输出。
+ *       缓冲区帧数必须是 group 的整数倍，并且第一帧是组内的第一个通道。
+ */
+HAL_StatusTypeDef DAC8568_Stream_SetLdacStrobe(uint8_t group)
+{
+    if (stream_dac != NULL)
+    {
+        return HAL_BUSY;
+    }
+    if (group > 8)
+    {
+        return HAL_ERROR;
+    }
+    stream_ldac_group = group;
+    return HAL_OK;
+}
+
+/**
+ * @brief 查询流式输出是否正在运行。
+ * @retval 1 运行中，0 已停止。
+ */
+uint8_t DAC8568_Stream_IsRunning(void)
+{
+    return stream_dac != NULL;
+}
@@ -0,0 +1,314 @@
+/*
+ * DAC8568 S曲线 (加加速度受限) 轨迹规划
+ * 作者: 雪豹
+ */
+#include "DAC8568_Traj.h"
+#include "DAC8568_Stream.h"
+
+// 7段的加加速度方向与段长 (len[] 的下标)
+static const int8_t traj_sign[7] = {1, 0, -1, 0, -1, 0, 1};
+static const uint8_t traj_len[7] = {0, 1, 0, 2, 0, 1, 0};
+
+/**
+ * @brief 初始化轨迹发生器，所有通道关闭。
+ * @param traj 轨迹发生器。
+ * @param sample_rate 每个通道的采样率 (Hz)，流式输出时为帧速率 / 启用通道数。
+ */
+void DAC8568_Traj_Init(DAC8568_Traj_HandleTypeDef *traj, uint32_t sample_rate)
+{
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        traj->ch[i].seg = DAC8568_TRAJ_IDLE;
+        traj->ch[i].enabled = 0;
+        traj->ch[i].hold = 0;
+    }
+    traj->sample_rate = sample_rate;
+    traj->active = 0;
+    traj->slot = 0;
+    traj->update_cmd = CMD_WRITE_INPUT_UPDATE_ALL;
+}
+
+/**
+ * @brief 启用通道并停在指定位置 (正在进行的运动被放弃)。
+ * @param traj 轨迹发生器。
+ * @param channel 通道 (CHANNEL_A 到 CHANNEL_H)。
+ * @param position 位置 (16位满量程)，通常为该通道当前的输出。
+ * @note 改变启用的通道会重排发送顺序，应在开始流式输出之前调用。
+ */
+void DAC8568_Traj_SetChannel(DAC8568_Traj_HandleTypeDef *traj, uint8_t channel, uint16_t position)
+{
+    DAC8568_Traj_ChannelTypeDef *c = &traj->ch[channel & 0x07];
+    c->seg = DAC8568_TRAJ_IDLE;
+    c->hold = position;
+    if (!c->enabled)
+    {
+        c->enabled = 1;
+        traj->active = 0;
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            if (traj->ch[i].enabled)
+            {
+                traj->order[traj->active++] = i;
+            }
+        }
+        traj->slot = 0;
+    }
+}
+
+/**
+ * @brief 把每秒的加速度/加加速度上限换算为每采样的Q46定点数。
+ * @param limit 上限 (16位满量程码值/s^order)，0表示不限制。
+ * @param sample_rate 采样率 (Hz)。
+ * @param order 2: 加速度；3: 加加速度。
+ * @retval Q46/采样^order，不限制或超出范围时为INT64_MAX。
+ * @note 每次除法之前尽量左移，保留有效位；只在规划时调用。
+ */
+static int64_t DAC8568_Traj_PerSample(uint32_t limit, uint32_t sample_rate, uint8_t order)
+{
+    uint64_t x = limit;
+    uint32_t shift = DAC8568_TRAJ_FRAC;
+    if (limit == 0)
+    {
+        return INT64_MAX;
+    }
+    for (uint8_t k = 0; k < order; k++)
+    {
+        while (shift > 0 && x < (1ULL << 62))
+        {
+            x <<= 1;
+            shift--;
+        }
+        x /= sample_rate;
+    }
+    if (x >= (1ULL << (62 - shift)))
+    {
+        return INT64_MAX;
+    }
+    return (int64_t)(x << shift);
+}
+
+/**
+ * @brief 计算单位加加速度 (J = 1) 下7段运动的总位移。
+ * @param n1 加加速度段长。
+ * @param n2 匀加速段长。
+ * @param n4 匀速段长。
+ * @retval 总位移，与每个采样 p += v; v += a; a += j 的递推结果完全相同。
+ * @note 长度为n、加加速度为j的一段: p += n·v + a·n(n-1)/2 + j·n(n-1)(n-2)/6，
+ *       v += n·a + j·n(n-1)/2，a += n·j。结束时速度与加速度都回到0。
+ */
+static int64_t DAC8568_Traj_UnitDistance(uint32_t n1, uint32_t n2, uint32_t n4)
+{
+    const uint32_t len[3] = {n1, n2, n4};
+    int64_t p = 0, v = 0, a = 0;
+    for (uint8_t s = 0; s < 7; s++)
+    {
+        int64_t n = len[traj_len[s]];
+        int64_t j = traj_sign[s];
+        p += n * v + a * (n * (n - 1) / 2) + j * (n * (n - 1) * (n - 2) / 6);
+        v += n * a + j * (n * (n - 1) / 2);
+        a += n * j;
+    }
+    return p;
+}
+
+/**
+ * @brief 规划一次从当前位置到目标的S曲线运动，之后每个采样按前向差分推进。
+ * @param traj 轨迹发生器。
+ * @param channel 通道 (已用 DAC8568_Traj_SetChannel 启用)。
+ * @param target 目标位置 (16位满量程)。
+ * @param samples 运动时长 (采样数，4 ~ DAC8568_TRAJ_MAX_SAMPLES)。
+ * @param accel_max 加速度上限 (码值/s²，16位满量程)，0表示不限制。
+ * @param jerk_max 加加速度上限 (码值/s³)，0表示不限制。
+ * @retval HAL_OK 已开始运动；HAL_BUSY 该通道仍在运动；
+ *         HAL_ERROR 通道未启用、参数无效，或在该时长内无法同时满足两个上限 (需要更长的时长)。
+ * @note 时长固定时峰值速度为 2·距离/时长，加速度在 4·距离/时长² (J→∞) 到 8·距离/时长² (无匀加速段) 之间。
+ *       在满足加速度上限的前提下选择加加速度最小的段长，计算包含二分查找与64位除法，只在规划时执行。
+ *       离散化后的实际峰值与上限的差别在一个采样的量级。
+ */
+HAL_StatusTypeDef DAC8568_Traj_Plan(DAC8568_Traj_HandleTypeDef *traj, uint8_t channel, uint16_t target,
+                                    uint32_t samples, uint32_t accel_max, uint32_t jerk_max)
+{
+    DAC8568_Traj_ChannelTypeDef *c = &traj->ch[channel & 0x07];
+    if (!c->enabled || samples < 4 || samples > DAC8568_TRAJ_MAX_SAMPLES || traj->sample_rate == 0)
+    {
+        return HAL_ERROR;
+    }
+    if (c->seg != DAC8568_TRAJ_IDLE)
+    {
+        return HAL_BUSY;
+    }
+    if (target == c->hold)
+    {
+        return HAL_OK;
+    }
+
+    int64_t distance = ((int64_t)target - c->hold) * ((int64_t)1 << DAC8568_TRAJ_FRAC);
+    int64_t magnitude = (distance < 0) ? -distance : distance;
+    int64_t a_max = DAC8568_Traj_PerSample(accel_max, traj->sample_rate, 2);
+    int64_t j_max = DAC8568_Traj_PerSample(jerk_max, traj->sample_rate, 3);
+
+    // 峰值加速度 J·n1 随 n1 单调增加，二分查找满足加速度上限的最大 n1
+    uint32_t lo = 1, hi = samples / 4U;
+    while (lo < hi)
+    {
+        uint32_t n1 = (lo + hi + 1U) / 2U;
+        uint32_t n2 = (samples - 4U * n1) / 2U;
+        int64_t jerk = magnitude / DAC8568_Traj_UnitDistance(n1, n2, samples - 4U * n1 - 2U * n2);
+        if (jerk * n1 <= a_max)
+        {
+            lo = n1;
+        }
+        else
+        {
+            hi = n1 - 1U;
+        }
+    }
+    uint32_t n1 = lo;
+    uint32_t n2 = (samples - 4U * n1) / 2U;
+    uint32_t n4 = samples - 4U * n1 - 2U * n2; // 0或1，吸收奇数时长
+    int64_t unit = DAC8568_Traj_UnitDistance(n1, n2, n4);
+    int64_t jerk = magnitude / unit;
+    if (jerk * n1 > a_max || jerk > j_max)
+    {
+        return HAL_ERROR;
+    }
+    int64_t bias = (magnitude - jerk * unit) / samples; // 余数折算为速度偏置 (小于 2^-11 码值/采样)
+
+    c->p = (int64_t)c->hold << DAC8568_TRAJ_FRAC;
+    c->v = (distance < 0) ? -bias : bias;
+    c->a = 0;
+    c->jerk = (distance < 0) ? -jerk : jerk;
+    c->j = c->jerk;
+    c->len[0] = n1;
+    c->len[1] = n2;
+    c->len[2] = n4;
+    c->left = n1;
+    __DMB(); // 运动参数写入完成后再启动 (求值可能在中断中进行)
+    c->seg = 0;
+    c->hold = target; // 运动期间不使用，结束后保持
+    return HAL_OK;
+}
+
+/**
+ * @brief 进入下一个非空的段，全部结束后停在目标上。
+ * @param c 通道轨迹状态。
+ */
+static void DAC8568_Traj_Advance(DAC8568_Traj_ChannelTypeDef *c)
+{
+    uint8_t seg = c->seg;
+    while (++seg < 7)
+    {
+        c->left = c->len[traj_len[seg]];
+        if (c->left != 0)
+        {
+            c->j = (traj_sign[seg] > 0) ? c->jerk : (traj_sign[seg] < 0) ? -c->jerk : 0;
+            c->seg = seg;
+            return;
+        }
+    }
+    c->seg = DAC8568_TRAJ_IDLE;
+}
+
+/**
+ * @brief 取出通道的下一个位置。
+ * @param c 通道轨迹状态。
+ * @retval 16位位置。
+ * @note 每个采样三次加法。先输出再递推，加速度经两级累加才体现在位置上，
+ *       运动的前3个输出为起点，第 samples 个输出为目标，曲线关于第 (samples+2)/2 个输出对称。
+ */
+static inline uint16_t DAC8568_Traj_Next(DAC8568_Traj_ChannelTypeDef *c)
+{
+    if (c->seg == DAC8568_TRAJ_IDLE)
+    {
+        return c->hold;
+    }
+    uint16_t x = (uint16_t)((c->p + ((int64_t)1 << (DAC8568_TRAJ_FRAC - 1))) >> DAC8568_TRAJ_FRAC);
+    c->p += c->v;
+    c->v += c->a;
+    c->a += c->j;
+    if (--c->left == 0)
+    {
+        DAC8568_Traj_Advance(c);
+    }
+    return x;
+}
+
+/**
+ * @brief 查询仍在运动的通道。
+ * @param traj 轨迹发生器。
+ * @retval 通道掩码，bit0对应通道A。
+ */
+uint8_t DAC8568_Traj_GetMoving(const DAC8568_Traj_HandleTypeDef *traj)
+{
+    uint8_t mask = 0;
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        if (traj->ch[i].seg != DAC8568_TRAJ_IDLE)
+        {
+            mask |= (uint8_t)(1U << i);
+        }
+    }
+    return mask;
+}
+
+/**
+ * @brief 计算所有启用通道的下一个采样 (定时器中断中使用)。
+ * @param traj 轨迹发生器。
+ * @param codes 输出: 原生分辨率码值，未启用的通道保持不变。
+ */
+void DAC8568_Traj_Step(DAC8568_Traj_HandleTypeDef *traj, uint16_t codes[8])
+{
+    for (uint8_t i = 0; i < traj->active; i++)
+    {
+        uint8_t ch = traj->order[i];
+        codes[ch] = DAC8568_DATA_TO_CODE(DAC8568_Traj_Next(&traj->ch[ch]));
+    }
+}
+
+/**
+ * @brief 选择流式帧的更新方式。
+ * @param traj 轨迹发生器。
+ * @param enable 1: 所有帧只写输入寄存器，由定时LDAC脉冲更新 (DAC8568_Stream_SetLdacStrobe)；
+ *               0: 每组最后一帧用 CMD_WRITE_INPUT_UPDATE_ALL 更新 (默认)。
+ */
+void DAC8568_Traj_SetLdacStrobe(DAC8568_Traj_HandleTypeDef *traj, uint8_t enable)
+{
+    traj->update_cmd = enable ? CMD_WRITE_INPUT_REG : CMD_WRITE_INPUT_UPDATE_ALL;
+}
+
+/**
+ * @brief 生成流式输出帧。
+ * @param traj 轨迹发生器。
+ * @param frames 输出缓冲区 (流式帧格式)。
+ * @param count 帧数，不必是启用通道数的整数倍，下一次调用从中断处继续。
+ * @note 帧格式与 DAC8568_DDS_Render 相同；静止的通道重复输出保持的位置。没有启用的通道时不修改缓冲区。
+ */
+void DAC8568_Traj_Render(DAC8568_Traj_HandleTypeDef *traj, uint32_t *frames, uint16_t count)
+{
+    if (traj->active == 0)
+    {
+        return;
+    }
+    uint8_t slot = traj->slot;
+    uint8_t last = traj->active - 1U;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        uint8_t ch = traj->order[slot];
+        uint16_t data = DAC8568_Traj_Next(&traj->ch[ch]);
+        uint8_t cmd = (slot == last) ? traj->update_cmd : CMD_WRITE_INPUT_REG;
+        frames[i] = DAC8568_STREAM_FRAME(cmd, ch, data, 0);
+        slot = (slot == last) ? 0 : slot + 1U;
+    }
+    traj->slot = slot;
+}
+
+/**
+ * @brief 乒乓流式输出的生成函数 (DAC8568_Stream_StartPingPong)。
+ * @param context 轨迹发生器 (DAC8568_Traj_HandleTypeDef *)。
+ * @param frames 待填充的半个缓冲区。
+ * @param count 帧数。
+ */
+void DAC8568_Traj_Generator(void *context, uint32_t *frames, uint16_t count)
+{
+    DAC8568_Traj_Render((DAC8568_Traj_HandleTypeDef *)context, frames, count);
+}
@@ -0,0 +1,269 @@
+/*
+ * DAC8568 Flash压缩波形回放
+ * 作者: 雪豹
+ */
+#include "DAC8568_Wave.h"
+#include "DAC8568_Stream.h"
+
+/**
+ * @brief 计算波形的块数。
+ * @param wave 波形描述符。
+ * @retval 块数。
+ */
+uint32_t DAC8568_Wave_GetBlockCount(const DAC8568_WaveTypeDef *wave)
+{
+    return (wave->samples + wave->block_len - 1U) / wave->block_len;
+}
+
+/**
+ * @brief 载入一块: 读出各通道的关键帧与模式，定位残差。
+ * @param dec 解码器。
+ * @param p 块的起始地址。
+ */
+static void DAC8568_Wave_LoadBlock(DAC8568_Wave_DecoderTypeDef *dec, const uint8_t *p)
+{
+    const DAC8568_WaveTypeDef *wave = dec->wave;
+    uint32_t remaining = wave->samples - dec->block * wave->block_len;
+    dec->length = (remaining < wave->block_len) ? (uint16_t)remaining : wave->block_len;
+    dec->index = 0;
+
+    for (uint8_t i = 0; i < dec->active; i++)
+    {
+        DAC8568_Wave_ChannelTypeDef *c = &dec->ch[dec->order[i]];
+        uint8_t mode = p[2];
+        c->value = (uint16_t)(p[0] | (p[1] << 8));
+        c->width = mode & DAC8568_WAVE_WIDTH_MASK;
+        c->linear = (mode & DAC8568_WAVE_PREDICT_LINEAR) ? 1U : 0U;
+        c->shift = mode >> DAC8568_WAVE_SHIFT_POS;
+        c->nibble = 0;
+        c->ptr = p + DAC8568_WAVE_RECORD_HEADER;
+        c->slope = 0;
+        if (c->linear)
+        {
+            c->slope = (int16_t)(c->ptr[0] | (c->ptr[1] << 8));
+            c->ptr += DAC8568_WAVE_SLOPE_SIZE;
+        }
+
+        // 记录长度: 4/8/16位残差分别为 (n-1)/2 (向上取整)、n-1、2(n-1) 字节
+        uint32_t bits = (c->width == DAC8568_WAVE_WIDTH_NONE) ? 0U : (2U << c->width);
+        p = c->ptr + (((uint32_t)dec->length - 1U) * bits + 7U) / 8U;
+    }
+    dec->next = p;
+}
+
+/**
+ * @brief 取出通道的下一个样本。
+ * @param dec 解码器。
+ * @param c 通道解码状态。
+ * @retval 16位样本。
+ * @note 每块第一组直接输出关键帧；播放完毕后保持最后的样本。
+ */
+static inline uint16_t DAC8568_Wave_Next(const DAC8568_Wave_DecoderTypeDef *dec, DAC8568_Wave_ChannelTypeDef *c)
+{
+    if (dec->index == 0 || dec->done)
+    {
+        return c->value;
+    }
+
+    int32_t r;
+    switch (c->width)
+    {
+    case DAC8568_WAVE_WIDTH_NONE:
+        r = 0;
+        break;
+    case DAC8568_WAVE_WIDTH_4:
+        if (c->nibble)
+        {
+            r = (int8_t)*c->ptr++ >> 4; // 高半字节，算术右移完成符号扩展
+        }
+        else
+        {
+            r = (int8_t)(*c->ptr << 4) >> 4;
+        }
+        c->nibble ^= 1U;
+        break;
+    case DAC8568_WAVE_WIDTH_8:
+        r = (int8_t)*c->ptr++;
+        break;
+    default:
+        r = (int16_t)(c->ptr[0] | (c->ptr[1] << 8));
+        c->ptr += 2;
+        break;
+    }
+
+    uint16_t x = (uint16_t)(c->value + c->slope + r * (1 << c->shift)); // 按16位取模，与编码器一致
+    if (c->linear)
+    {
+        c->slope = (int16_t)(uint16_t)(x - c->value);
+    }
+    c->value = x;
+    return x;
+}
+
+/**
+ * @brief 一组样本输出完毕，前进到下一组，必要时载入下一块。
+ * @param dec 解码器。
+ */
+static void DAC8568_Wave_EndGroup(DAC8568_Wave_DecoderTypeDef *dec)
+{
+    if (dec->done || ++dec->index < dec->length)
+    {
+        return;
+    }
+    if (++dec->block < DAC8568_Wave_GetBlockCount(dec->wave))
+    {
+        DAC8568_Wave_LoadBlock(dec, dec->next);
+    }
+    else if (dec->loop)
+    {
+        dec->block = 0;
+        DAC8568_Wave_LoadBlock(dec, dec->wave->data);
+    }
+    else
+    {
+        dec->block--;
+        dec->done = 1;
+    }
+}
+
+/**
+ * @brief 初始化解码器并定位到波形开头。
+ * @param dec 解码器。
+ * @param wave 波形描述符，回放期间必须保持有效。
+ * @param loop 1: 播放到结尾后从头循环；0: 播放一次后保持最后的样本。
+ * @retval HAL_OK 成功；HAL_ERROR 描述符无效。
+ */
+HAL_StatusTypeDef DAC8568_Wave_Init(DAC8568_Wave_DecoderTypeDef *dec, const DAC8568_WaveTypeDef *wave, uint8_t loop)
+{
+    if (wave == NULL || wave->data == NULL || wave->samples == 0 || wave->block_len == 0 || wave->channel_mask == 0)
+    {
+        return HAL_ERROR;
+    }
+
+    dec->wave = wave;
+    dec->loop = loop;
+    dec->done = 0;
+    dec->slot = 0;
+    dec->block = 0;
+    dec->active = 0;
+    dec->update_cmd = CMD_WRITE_INPUT_UPDATE_ALL;
+    for (uint8_t ch = 0; ch < 8; ch++)
+    {
+        if (wave->channel_mask & (1U << ch))
+        {
+            dec->order[dec->active++] = ch;
+        }
+    }
+    DAC8568_Wave_LoadBlock(dec, wave->data);
+    return HAL_OK;
+}
+
+/**
+ * @brief 跳转到指定样本。
+ * @param dec 解码器 (已初始化)。
+ * @param sample 每通道的样本序号。
+ * @retval HAL_OK 成功；HAL_ERROR 超出范围或波形没有块偏移表。
+ * @note 由块偏移表直接定位到所在块，块内最多解码 block_len - 1 组。
+ */
+HAL_StatusTypeDef DAC8568_Wave_Seek(DAC8568_Wave_DecoderTypeDef *dec, uint32_t sample)
+{
+    const DAC8568_WaveTypeDef *wave = dec->wave;
+    if (wave->block_offset == NULL || sample >= wave->samples)
+    {
+        return HAL_ERROR;
+    }
+
+    dec->done = 0;
+    dec->slot = 0;
+    dec->block = sample / wave->block_len;
+    DAC8568_Wave_LoadBlock(dec, wave->data + wave->block_offset[dec->block]);
+    for (uint32_t n = sample % wave->block_len; n > 0; n--)
+    {
+        for (uint8_t i = 0; i < dec->active; i++)
+        {
+            (void)DAC8568_Wave_Next(dec, &dec->ch[dec->order[i]]);
+        }
+        DAC8568_Wave_EndGroup(dec);
+    }
+    return HAL_OK;
+}
+
+/**
+ * @brief 解码一组样本 (定时器中断中使用)。
+ * @param dec 解码器。
+ * @param codes 输出: 原生分辨率码值，波形不包含的通道保持不变。
+ * @note 与 DAC8568_Wave_Render 不要混用在同一个解码器上 (Render 可能停在组的中间)。
+ */
+void DAC8568_Wave_Step(DAC8568_Wave_DecoderTypeDef *dec, uint16_t codes[8])
+{
+    for (uint8_t i = 0; i < dec->active; i++)
+    {
+        uint8_t ch = dec->order[i];
+        codes[ch] = DAC8568_DATA_TO_CODE(DAC8568_Wave_Next(dec, &dec->ch[ch]));
+    }
+    DAC8568_Wave_EndGroup(dec);
+}
+
+/**
+ * @brief 选择流式帧的更新方式。
+ * @param dec 解码器 (已初始化，DAC8568_Wave_Init 恢复为默认)。
+ * @param enable 1: 所有帧只写输入寄存器，由定时LDAC脉冲更新 (DAC8568_Stream_SetLdacStrobe)；
+ *               0: 每组最后一帧用 CMD_WRITE_INPUT_UPDATE_ALL 更新 (默认)。
+ */
+void DAC8568_Wave_SetLdacStrobe(DAC8568_Wave_DecoderTypeDef *dec, uint8_t enable)
+{
+    dec->update_cmd = enable ? CMD_WRITE_INPUT_REG : CMD_WRITE_INPUT_UPDATE_ALL;
+}
+
+/**
+ * @brief 解码并生成流式输出帧。
+ * @param dec 解码器。
+ * @param frames 输出缓冲区 (流式帧格式)。
+ * @param count 帧数，不必是通道数的整数倍，下一次调用从中断处继续。
+ * @note 帧格式与 DAC8568_DDS_Render 相同: 包含的通道按A到H的顺序轮流输出一帧，
+ *       每组最后一帧用 CMD_WRITE_INPUT_UPDATE_ALL 同时更新整组 (定时LDAC时由LDAC脉冲更新)。
+ */
+void DAC8568_Wave_Render(DAC8568_Wave_DecoderTypeDef *dec, uint32_t *frames, uint16_t count)
+{
+    uint8_t slot = dec->slot;
+    uint8_t last = dec->active - 1U;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        uint8_t ch = dec->order[slot];
+        uint16_t data = DAC8568_Wave_Next(dec, &dec->ch[ch]);
+        if (slot == last)
+        {
+            frames[i] = DAC8568_STREAM_FRAME(dec->update_cmd, ch, data, 0);
+            DAC8568_Wave_EndGroup(dec);
+            slot = 0;
+        }
+        else
+        {
+            frames[i] = DAC8568_STREAM_FRAME(CMD_WRITE_INPUT_REG, ch, data, 0);
+            slot++;
+        }
+    }
+    dec->slot = slot;
+}
+
+/**
+ * @brief 乒乓流式输出的生成函数 (DAC8568_Stream_StartPingPong)。
+ * @param context 波形解码器 (DAC8568_Wave_DecoderTypeDef *)。
+ * @param frames 待填充的半个缓冲区。
+ * @param count 帧数。
+ * @note 播放完毕 (不循环) 后继续输出最后的样本。
+ */
+void DAC8568_Wave_Generator(void *context, uint32_t *frames, uint16_t count)
+{
+    DAC8568_Wave_Render((DAC8568_Wave_DecoderTypeDef *)context, frames, count);
+}
+
+/**
+ * @brief 查询波形是否已播放完毕。
+ * @param dec 解码器。
+ * @retval 1 已播放完毕 (仅在不循环时)，0 仍在播放。
+ */
+uint8_t DAC8568_Wave_IsDone(const DAC8568_Wave_DecoderTypeDef *dec)
+{
+    return dec->done;
+}
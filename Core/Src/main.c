@@ -25,7 +25,8 @@
  * ----------------------------------------------------------------
  * 参数要求（参考数据手册第7-8页时序图和第6页电气特性）：
  * 1. 模式: 全双工主模式 (DAC8568 为从设备)
- * 2. 数据大小: 8位 (需手动组合为24/32位帧)
+ * 2. 数据大小: 8位或16位 (驱动在初始化时读取 hspi->Init.DataSize 自动选择帧格式，
+ *    16位模式下每个32位帧只需两次DR写入/两次DMA搬运，推荐使用)
  * 3. 时钟极性 (CPOL): 高电平空闲 (CPOL=high)
  * 4. 时钟相位 (CPHA): 数据在第一个边沿采样 (CPHA=0)
  * 5. 传输顺序: MSB 高位在前 (强制要求)
@@ -35,7 +36,7 @@
  * CubeMX 具体设置步骤：
  * 1. Connectivity → SPIx → Mode = "Full-Duplex Master"
  * 2. Parameter Settings →
- *    - Data Size = 8 Bits
+ *    - Data Size = 16 Bits (8 Bits亦可)
  *    - First Bit = MSB First
  *    - Clock Polarity = High  注意这个
  *    - Clock Phase = 1 Edge
@@ -59,12 +60,13 @@
 /* USER CODE END Header */
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
+#include "dma.h"
 #include "spi.h"
 #include "gpio.h"
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
-#include "dac8568.h" // 包含DAC8568的头文件
+#include "DAC8568.h" // 包含DAC8568的头文件
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -85,7 +87,8 @@
 /* Private variables ---------------------------------------------------------*/
 
 /* USER CODE BEGIN PV */
-
+DAC8568_HandleTypeDef hdac1; // SPI1上的DAC8568 (SYNC: PA4)
+DAC8568_HandleTypeDef hdac2; // SPI2上的DAC8568 (SYNC2: PB12)
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -128,13 +131,17 @@ int main(void)
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
+  MX_DMA_Init();
   MX_SPI1_Init();
+  MX_SPI2_Init();
   /* USER CODE BEGIN 2 */
-  // 初始化DAC8568 (SYNC连接到PA4)
-  DAC8568_Init(&hspi1, SYNC_GPIO_Port, SYNC_Pin);
-  HAL_Delay(10);
-  DAC8568_EnableStaticInternalRef(); // 启用静态内部参考(2.5V)
-  // DAC8568_DisableStaticInternalRef(); // 禁用静态内部参考(2.5V)
+  // 初始化DAC8568 (第一片SYNC连接到PA4，第二片SYNC连接到PB12)
+  DAC8568_Init(&hdac1, &hspi1, SYNC_GPIO_Port, SYNC_Pin);
+  DAC8568_Init(&hdac2, &hspi2, SYNC2_GPIO_Port, SYNC2_Pin); // 复位恢复时间由驱动在下一帧前等待
+  DAC8568_AttachLdacPin(&hdac1, LDAC_GPIO_Port, LDAC_Pin);  // 第一片的LDAC连接到PB6 (可选)
+  DAC8568_EnableStaticInternalRef(&hdac1); // 启用静态内部参考(2.5V)
+  DAC8568_EnableStaticInternalRef(&hdac2);
+  // DAC8568_DisableStaticInternalRef(&hdac1); // 禁用静态内部参考(2.5V)
 
   /* USER CODE END 2 */
 
@@ -146,10 +153,10 @@ int main(void)
     for (int i = 65535; i >= 0; i = i - 4096) // 从65535到0，步长4096
     {
       HAL_GPIO_TogglePin(LED_GPIO_Port, LED_Pin);     // 翻转LED引脚的状态
-      DAC8568_WriteAndUpdate(BROADCAST, (uint16_t)i); // 写入并更新所有通道的值 (强制类型转换为uint16_t)
-      // DAC8568_WriteAndUpdate(CHANNEL_A, (uint16_t)i); // 写入并更新通道A的值 (强制类型转换为uint16_t)
-      // DAC8568_WriteAndUpdate(CHANNEL_B, (uint16_t)i); // 写入并更新通道B的值 (强制类型转换为uint16_t)
-      float voltage = 2.5 * 2 * i / 65536;         // 计算电压值 (假设Vref=2.5V，16位分辨率)
+      DAC8568_WriteAndUpdate(&hdac1, BROADCAST, (uint16_t)i); // 写入并更新所有通道的值 (强制类型转换为uint16_t)
+      DAC8568_WriteAndUpdate(&hdac2, BROADCAST, (uint16_t)i); // 两片DAC位于不同SPI总线，DMA传输可同时进行
+      // DAC8568_WriteAndUpdate(&hdac1, CHANNEL_A, (uint16_t)i); // 写入并更新通道A的值 (强制类型转换为uint16_t)
+      // DAC8568_WriteAndUpdate(&hdac1, CHANNEL_B, (uint16_t)i); // 写入并更新通道B的值 (强制类型转换为uint16_t)
       HAL_Delay(2000);                             // 稍微缩短延时以便观察变化，可根据需要调整
     }
 
@@ -199,7 +206,23 @@ void SystemClock_Config(void)
 }
 
 /* USER CODE BEGIN 4 */
+/**
+ * @brief SPI发送完成回调，转发给DAC8568驱动以拉高SYNC。
+ * @param hspi SPI句柄
+ */
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+  DAC8568_TxCpltCallback(hspi);
+}
 
+/**
+ * @brief SPI错误回调，转发给DAC8568驱动以释放SYNC。
+ * @param hspi SPI句柄
+ */
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+  DAC8568_ErrorCallback(hspi);
+}
 /* USER CODE END 4 */
 
 /**
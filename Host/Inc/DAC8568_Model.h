@@ -0,0 +1,69 @@
+/*
+ * DAC8568 行为模型 (主机端仿真)
+ * 作者: 雪豹
+ */
+/*
+ * 模型内容 (参考数据手册第35-47页命令表):
+ * ----------------------------------------------------------------
+ * - 串行接口: SYNC下降沿开始计数，第32个SCLK时锁存并执行该帧，
+ *   不足32位即拉高SYNC则丢弃该帧 (计入 aborted)
+ * - 8个输入寄存器、8个DAC寄存器
+ * - LDAC寄存器: 对应位为1的通道在写入输入寄存器时立即更新DAC寄存器
+ * - 各通道电源模式、清除代码寄存器
+ * - 内部参考: 静态模式开关，以及最近一次灵活模式命令的数据位
+ * - 软件复位 (命令0111) 与硬件LDAC/CLR引脚
+ *
+ * 时序: 每次DAC寄存器更新记录当时的虚拟CPU周期数，可用于统计更新间隔与吞吐量。
+ */
+
+#ifndef DAC8568_MODEL_H
+#define DAC8568_MODEL_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+    /**
+     * @brief DAC8568行为模型状态。
+     */
+    typedef struct
+    {
+        // 芯片寄存器
+        uint16_t input_reg[8];  // 输入寄存器
+        uint16_t dac_reg[8];    // DAC寄存器 (决定输出电压)
+        uint8_t ldac_mask;      // LDAC寄存器，bit0对应通道A
+        uint8_t power_mode[8];  // 各通道电源模式 (POWER_UP ~ POWER_DOWN_HIZ)
+        uint8_t clear_code;     // 清除代码 (CLEAR_CODE_ZERO_SCALE ~ CLEAR_CODE_NO_OPERATION)
+        uint8_t ref_static;     // 静态模式内部参考: 1开启，0关闭
+        uint16_t ref_flex;      // 最近一次灵活模式参考命令的数据位 (DB19-DB4)
+        uint16_t reset_code;    // 上电/复位后的DAC码 (A/C等级为0，B/D等级为0x8000)
+
+        // 串行接口状态
+        uint8_t sync_low;  // SYNC当前为低电平
+        uint8_t bit_count; // 本帧已移入的位数
+        uint32_t shift;    // 移位寄存器
+
+        // 统计
+        uint32_t frames;          // 已执行的帧数
+        uint32_t aborted;         // 不足32位被丢弃的帧数
+        uint32_t resets;          // 软件复位次数
+        uint64_t reset_cycle;     // 最近一次软件复位时的虚拟周期数
+        uint32_t last_frame;      // 最近一次执行的帧 (数值形式)
+        uint64_t update_cycle[8]; // 各通道DAC寄存器最近一次更新时的虚拟周期数
+    } DAC8568_ModelTypeDef;
+
+    void DAC8568_Model_Init(DAC8568_ModelTypeDef *model, uint16_t reset_code);
+    void DAC8568_Model_Reset(DAC8568_ModelTypeDef *model);
+    void DAC8568_Model_SetSync(DAC8568_ModelTypeDef *model, uint8_t level);
+    void DAC8568_Model_Shift(DAC8568_ModelTypeDef *model, uint32_t bits, uint8_t width);
+    void DAC8568_Model_Execute(DAC8568_ModelTypeDef *model, uint32_t frame);
+    void DAC8568_Model_PulseLdac(DAC8568_ModelTypeDef *model);
+    void DAC8568_Model_Clear(DAC8568_ModelTypeDef *model);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* DAC8568_MODEL_H */
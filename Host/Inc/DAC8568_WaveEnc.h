@@ -0,0 +1,44 @@
+/*
+ * DAC8568 压缩波形编码器 (主机端)
+ * 作者: 雪豹
+ */
+/*
+ * 生成 DAC8568_Wave.h 描述的块格式。对每块每通道尝试两种预测器、各残差宽度与量化移位，
+ * 按解码器完全相同的取模运算闭环重建，选择重建误差不超过 tolerance 的最短记录；
+ * 都不满足时退回16位无损残差。tolerance = 0 时整个波形无损。
+ */
+
+#ifndef DAC8568_WAVEENC_H
+#define DAC8568_WAVEENC_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include "DAC8568_Wave.h"
+
+    /**
+     * @brief 编码结果，data 与 block_offset 由编码器分配。
+     */
+    typedef struct
+    {
+        uint8_t *data;           // 块数据
+        size_t size;             // 块数据字节数
+        uint32_t *block_offset;  // 每块的起始偏移
+        uint32_t blocks;         // 块数
+        uint32_t max_error;      // 实际最大重建误差 (LSB，16位满量程)
+        uint32_t mode_count[4];  // 各残差宽度的记录数 (无/4位/8位/16位)
+        DAC8568_WaveTypeDef wave; // 指向上面两个数组的描述符，可直接交给解码器
+    } DAC8568_WaveEnc_ResultTypeDef;
+
+    // 函数声明
+    int DAC8568_WaveEnc_Encode(const uint16_t *const samples[8], uint8_t channel_mask, uint32_t count,
+                               uint16_t block_len, uint16_t tolerance, DAC8568_WaveEnc_ResultTypeDef *out);
+    void DAC8568_WaveEnc_Free(DAC8568_WaveEnc_ResultTypeDef *out);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* DAC8568_WAVEENC_H */
@@ -0,0 +1,72 @@
+/*
+ * 主机仿真环境: 虚拟时钟与模型挂接
+ * 作者: 雪豹
+ */
+
+#ifndef HOST_SIM_H
+#define HOST_SIM_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "stm32f1xx_hal.h"
+#include "DAC8568_Model.h"
+
+// CPU开销估计值 (72MHz Cortex-M3，-O2编译的F1 HAL)。
+// 虚拟时钟由HAL替身的固定开销、SPI移位时间和驱动代码的基本块计数推进：驱动源文件以
+// -fsanitize-coverage=trace-pc 编译 (见 Host/Makefile)，每执行一个基本块计 HOST_CYCLES_BLOCK 个周期。
+// 基本块按主机编译器的划分计数，与ARM代码不完全一致，但增加了分支、循环或函数调用的热路径会在结果中体现。
+// 实际开销以目标板上的DWT周期计数为准。
+#ifndef HOST_CYCLES_BLOCK
+#define HOST_CYCLES_BLOCK 6 // 驱动代码每个基本块 (约4~5条Thumb-2指令，含Flash等待状态)
+#endif
+#ifndef HOST_CYCLES_GPIO_WRITE
+#define HOST_CYCLES_GPIO_WRITE 12 // HAL_GPIO_WritePin 调用与BSRR写入
+#endif
+#ifndef HOST_CYCLES_REG_ACCESS
+#define HOST_CYCLES_REG_ACCESS 2 // READ_REG/WRITE_REG 访问外设寄存器的APB桥等待 (指令本身计入基本块)
+#endif
+#ifndef HOST_CYCLES_SPI_CALL
+#define HOST_CYCLES_SPI_CALL 180 // HAL_SPI_Transmit 加锁、状态检查、HAL_GetTick与结束检查 (不含轮询循环)
+#endif
+#ifndef HOST_CYCLES_SPI_POLL
+#define HOST_CYCLES_SPI_POLL 10 // HAL轮询循环读一次SR并判断标志/超时
+#endif
+#ifndef HOST_CYCLES_SPI_ITEM
+#define HOST_CYCLES_SPI_ITEM 14 // HAL写一次DR并更新缓冲区指针与计数
+#endif
+#ifndef HOST_CYCLES_DMA_START
+#define HOST_CYCLES_DMA_START 220 // HAL_SPI_Transmit_DMA 与 HAL_DMA_Start_IT
+#endif
+#ifndef HOST_CYCLES_DMA_IRQ
+#define HOST_CYCLES_DMA_IRQ 260 // DMA中断入口、HAL_DMA_IRQHandler、结束检查与回调分发
+#endif
+
+#define HOST_MAX_MODELS 4
+
+    /**
+     * @brief SPI外设的访问计数 (自上次 Host_ResetSpiStats 起)。
+     */
+    typedef struct
+    {
+        uint32_t dr_writes; // CPU写DR的次数 (每个数据项一次)
+        uint32_t sr_reads;  // CPU读SR的次数 (TXE/BSY轮询，含等待移位期间的重复读取)
+        uint32_t dma_items; // DMA搬运的数据项数
+    } Host_SpiStatsTypeDef;
+
+    void Host_AttachModel(DAC8568_ModelTypeDef *model, SPI_TypeDef *spi, GPIO_TypeDef *sync_port, uint16_t sync_pin);
+    void Host_AttachLdac(DAC8568_ModelTypeDef *model, GPIO_TypeDef *ldac_port, uint16_t ldac_pin);
+    void Host_DetachAll(void);
+    uint64_t Host_GetCycles(void);
+    void Host_AddCycles(uint64_t cycles);
+    uint32_t Host_GetSpiBitCycles(const SPI_HandleTypeDef *hspi);
+    void Host_GetSpiStats(const SPI_TypeDef *spi, Host_SpiStatsTypeDef *stats);
+    void Host_ResetSpiStats(void);
+    void Host_SetPreempt(void (*isr)(void));
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* HOST_SIM_H */
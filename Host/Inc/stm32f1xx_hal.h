@@ -0,0 +1,242 @@
+/*
+ * 主机端 HAL 替身 (仅用于Linux下编译驱动与行为仿真，不参与目标板构建)
+ * 作者: 雪豹
+ */
+/*
+ * 说明:
+ * ----------------------------------------------------------------
+ * Core/Inc/main.h 通过 #include "stm32f1xx_hal.h" 引入HAL，主机构建时
+ * Host/Inc 位于包含路径最前面，由本文件代替真正的HAL头文件。
+ * 只提供 DAC8568.c 用到的类型、常量和函数，寄存器以普通内存模拟。
+ *
+ * 函数实现见 Host/Src/hal_shim.c：
+ * - GPIO写入会通知挂接在该引脚上的DAC8568模型 (SYNC边沿)；
+ * - SPI外设按寄存器级模拟: DR写入进入发送缓冲区/移位寄存器，SR的TXE/BSY随虚拟时钟变化，
+ *   每个数据项移位结束时移入模型；HAL_SPI_Transmit 按HAL的逐项轮询流程读写这些寄存器；
+ * - DMA发送在函数内完成数据搬运，随后模拟传输完成中断调用 HAL_SPI_TxCpltCallback；
+ * - HAL_GetTick / HAL_Delay 与 DWT->CYCCNT 基于虚拟周期计数，不依赖主机时间。
+ *
+ * 寄存器级后端 (DAC8568_BACKEND_REG) 通过CMSIS的 READ_REG/WRITE_REG/SET_BIT 访问外设，
+ * 替身把这三个宏换成 Host_ReadReg/Host_WriteReg: SPI的SR/DR与GPIO的BSRR进入外设模拟，
+ * 其它寄存器按普通内存读写。两种后端都能在主机上编译运行 (见 Host/Makefile)。
+ */
+
+#ifndef STM32F1XX_HAL_H
+#define STM32F1XX_HAL_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+    typedef enum
+    {
+        HAL_OK = 0x00U,
+        HAL_ERROR = 0x01U,
+        HAL_BUSY = 0x02U,
+        HAL_TIMEOUT = 0x03U
+    } HAL_StatusTypeDef;
+
+    // GPIO
+    typedef struct
+    {
+        volatile uint32_t CRL;
+        volatile uint32_t CRH;
+        volatile uint32_t IDR;
+        volatile uint32_t ODR;
+        volatile uint32_t BSRR;
+        volatile uint32_t BRR;
+        volatile uint32_t LCKR;
+    } GPIO_TypeDef;
+
+    typedef enum
+    {
+        GPIO_PIN_RESET = 0U,
+        GPIO_PIN_SET
+    } GPIO_PinState;
+
+#define GPIO_PIN_0 ((uint16_t)0x0001)
+#define GPIO_PIN_1 ((uint16_t)0x0002)
+#define GPIO_PIN_2 ((uint16_t)0x0004)
+#define GPIO_PIN_3 ((uint16_t)0x0008)
+#define GPIO_PIN_4 ((uint16_t)0x0010)
+#define GPIO_PIN_5 ((uint16_t)0x0020)
+#define GPIO_PIN_6 ((uint16_t)0x0040)
+#define GPIO_PIN_7 ((uint16_t)0x0080)
+#define GPIO_PIN_8 ((uint16_t)0x0100)
+#define GPIO_PIN_9 ((uint16_t)0x0200)
+#define GPIO_PIN_10 ((uint16_t)0x0400)
+#define GPIO_PIN_11 ((uint16_t)0x0800)
+#define GPIO_PIN_12 ((uint16_t)0x1000)
+#define GPIO_PIN_13 ((uint16_t)0x2000)
+#define GPIO_PIN_14 ((uint16_t)0x4000)
+#define GPIO_PIN_15 ((uint16_t)0x8000)
+
+    // SPI
+    typedef struct
+    {
+        volatile uint32_t CR1;
+        volatile uint32_t CR2;
+        volatile uint32_t SR;
+        volatile uint32_t DR;
+        volatile uint32_t CRCPR;
+        volatile uint32_t RXCRCR;
+        volatile uint32_t TXCRCR;
+        volatile uint32_t I2SCFGR;
+    } SPI_TypeDef;
+
+    typedef struct
+    {
+        uint32_t Mode;
+        uint32_t Direction;
+        uint32_t DataSize;
+        uint32_t CLKPolarity;
+        uint32_t CLKPhase;
+        uint32_t NSS;
+        uint32_t BaudRatePrescaler;
+        uint32_t FirstBit;
+    } SPI_InitTypeDef;
+
+    typedef enum
+    {
+        HAL_SPI_STATE_RESET = 0x00U,
+        HAL_SPI_STATE_READY = 0x01U,
+        HAL_SPI_STATE_BUSY = 0x02U,
+        HAL_SPI_STATE_BUSY_TX = 0x03U,
+        HAL_SPI_STATE_ERROR = 0x06U
+    } HAL_SPI_StateTypeDef;
+
+    typedef struct
+    {
+        void *Instance; // 替身中DMA通道不模拟寄存器，只用于表示已关联DMA
+    } DMA_HandleTypeDef;
+
+    typedef struct __SPI_HandleTypeDef
+    {
+        SPI_TypeDef *Instance;
+        SPI_InitTypeDef Init;
+        DMA_HandleTypeDef *hdmatx;
+        DMA_HandleTypeDef *hdmarx;
+        volatile HAL_SPI_StateTypeDef State;
+        volatile uint32_t ErrorCode;
+    } SPI_HandleTypeDef;
+
+#define SPI_DATASIZE_8BIT 0x00000000U
+#define SPI_DATASIZE_16BIT 0x00000800U // 与CR1的DFF位相同
+
+#define SPI_BAUDRATEPRESCALER_2 0x00000000U
+#define SPI_BAUDRATEPRESCALER_4 0x00000008U
+#define SPI_BAUDRATEPRESCALER_8 0x00000010U
+#define SPI_BAUDRATEPRESCALER_16 0x00000018U
+#define SPI_BAUDRATEPRESCALER_32 0x00000020U
+#define SPI_BAUDRATEPRESCALER_64 0x00000028U
+#define SPI_BAUDRATEPRESCALER_128 0x00000030U
+#define SPI_BAUDRATEPRESCALER_256 0x00000038U
+
+// SPI寄存器位 (替身按CR1的DFF/BR位与DR写入模拟发送缓冲区和移位寄存器，SR的TXE/BSY随虚拟时钟变化)
+#define SPI_CR1_MSTR 0x00000004U
+#define SPI_CR1_BR_Pos 3U
+#define SPI_CR1_BR 0x00000038U
+#define SPI_CR1_SPE 0x00000040U
+#define SPI_CR1_DFF 0x00000800U
+#define SPI_SR_TXE 0x00000002U
+#define SPI_SR_BSY 0x00000080U
+
+#define HAL_MAX_DELAY 0xFFFFFFFFU
+
+    // 外设实例 (普通内存)
+    extern GPIO_TypeDef Host_GPIOA, Host_GPIOB, Host_GPIOC;
+    extern SPI_TypeDef Host_SPI1, Host_SPI2;
+#define GPIOA (&Host_GPIOA)
+#define GPIOB (&Host_GPIOB)
+#define GPIOC (&Host_GPIOC)
+#define SPI1 (&Host_SPI1)
+#define SPI2 (&Host_SPI2)
+
+    extern uint32_t SystemCoreClock;
+
+    // 内核调试单元 (DWT周期计数器由虚拟时钟驱动)
+    typedef struct
+    {
+        volatile uint32_t CTRL;
+        volatile uint32_t CYCCNT;
+    } DWT_Type;
+
+    typedef struct
+    {
+        volatile uint32_t DHCSR;
+        volatile uint32_t DCRSR;
+        volatile uint32_t DCRDR;
+        volatile uint32_t DEMCR;
+    } CoreDebug_Type;
+
+    extern DWT_Type Host_DWT;
+    extern CoreDebug_Type Host_CoreDebug;
+#define DWT (&Host_DWT)
+#define CoreDebug (&Host_CoreDebug)
+#define DWT_CTRL_CYCCNTENA_Msk (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+
+    // CMSIS寄存器访问宏: 经过外设模拟
+    uint32_t Host_ReadReg(volatile uint32_t *reg);
+    void Host_WriteReg(volatile uint32_t *reg, uint32_t value);
+#define READ_REG(REG) Host_ReadReg(&(REG))
+#define WRITE_REG(REG, VAL) Host_WriteReg(&(REG), (VAL))
+#define SET_BIT(REG, BIT) WRITE_REG((REG), READ_REG(REG) | (BIT))
+
+    // CMSIS内建函数
+    static inline uint32_t __REV(uint32_t value)
+    {
+        return __builtin_bswap32(value);
+    }
+
+    static inline void __DMB(void)
+    {
+        __sync_synchronize();
+    }
+
+    // 中断屏蔽: 主机上没有真正的中断 (DMA完成回调在HAL调用中同步分发)，只记录PRIMASK的值
+    extern uint32_t Host_PRIMASK;
+    static inline uint32_t __get_PRIMASK(void)
+    {
+        return Host_PRIMASK;
+    }
+
+    static inline void __set_PRIMASK(uint32_t primask)
+    {
+        Host_PRIMASK = primask;
+    }
+
+    static inline void __disable_irq(void)
+    {
+        Host_PRIMASK = 1;
+    }
+
+    // 忙等待循环中的空操作: 推进虚拟时钟 (含循环开销)，使基于DWT->CYCCNT的等待能够结束
+    void Host_AddCycles(uint64_t cycles);
+    static inline void __NOP(void)
+    {
+        Host_AddCycles(4);
+    }
+
+    // HAL函数
+    void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+    GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+    HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef *hspi);
+    HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+    HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size);
+    void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi);
+    void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi);
+    void HAL_Delay(uint32_t Delay);
+    uint32_t HAL_GetTick(void);
+    uint32_t HAL_RCC_GetHCLKFreq(void);
+    uint32_t HAL_RCC_GetPCLK1Freq(void);
+    uint32_t HAL_RCC_GetPCLK2Freq(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* STM32F1XX_HAL_H */
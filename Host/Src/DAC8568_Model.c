@@ -0,0 +1,232 @@
+/*
+ * DAC8568 行为模型 (主机端仿真)
+ * 作者: 雪豹
+ */
+#include "DAC8568_Model.h"
+#include "host_sim.h"
+#include "DAC8568.h"
+
+/**
+ * @brief 初始化模型，相当于上电。
+ * @param model DAC模型。
+ * @param reset_code 上电/复位后的DAC码 (A/C等级为0，B/D等级为0x8000)。
+ */
+void DAC8568_Model_Init(DAC8568_ModelTypeDef *model, uint16_t reset_code)
+{
+    model->reset_code = reset_code;
+    model->sync_low = 0;
+    model->bit_count = 0;
+    model->shift = 0;
+    model->frames = 0;
+    model->aborted = 0;
+    model->resets = 0;
+    model->reset_cycle = 0;
+    model->last_frame = 0;
+    DAC8568_Model_Reset(model);
+}
+
+/**
+ * @brief 将所有寄存器恢复为上电默认值 (参考数据手册第39页表6)。
+ * @param model DAC模型。
+ */
+void DAC8568_Model_Reset(DAC8568_ModelTypeDef *model)
+{
+    uint64_t now = Host_GetCycles();
+    for (uint8_t ch = 0; ch < 8; ch++)
+    {
+        model->input_reg[ch] = model->reset_code;
+        model->dac_reg[ch] = model->reset_code;
+        model->power_mode[ch] = POWER_UP;
+        model->update_cycle[ch] = now;
+    }
+    model->ldac_mask = 0;
+    model->clear_code = CLEAR_CODE_ZERO_SCALE;
+    model->ref_static = 0;
+    model->ref_flex = 0;
+}
+
+/**
+ * @brief SYNC引脚电平变化。
+ * @param model DAC模型。
+ * @param level 新电平: 0低，1高。
+ * @note 下降沿开始新的一帧；不足32位时的上升沿使该帧作废。
+ */
+void DAC8568_Model_SetSync(DAC8568_ModelTypeDef *model, uint8_t level)
+{
+    if (!level)
+    {
+        model->sync_low = 1;
+        model->bit_count = 0;
+        model->shift = 0;
+        return;
+    }
+    if (model->sync_low && model->bit_count < 32)
+    {
+        model->aborted++;
+    }
+    model->sync_low = 0;
+}
+
+/**
+ * @brief 移入一个SPI数据帧 (MSB在前)。
+ * @param model DAC模型。
+ * @param bits 数据。
+ * @param width 位数 (8或16)。
+ * @note 第32位移入时立即执行该帧，此后直到SYNC拉高前的数据被忽略。
+ */
+void DAC8568_Model_Shift(DAC8568_ModelTypeDef *model, uint32_t bits, uint8_t width)
+{
+    if (!model->sync_low)
+    {
+        return; // SYNC为高时DIN被忽略
+    }
+    for (int8_t i = (int8_t)(width - 1); i >= 0; i--)
+    {
+        if (model->bit_count >= 32)
+        {
+            return;
+        }
+        model->shift = (model->shift << 1) | ((bits >> i) & 1U);
+        if (++model->bit_count == 32)
+        {
+            DAC8568_Model_Execute(model, model->shift);
+        }
+    }
+}
+
+/**
+ * @brief 更新一个通道的DAC寄存器。
+ */
+static void DAC8568_Model_Load(DAC8568_ModelTypeDef *model, uint8_t ch)
+{
+    model->dac_reg[ch] = model->input_reg[ch];
+    model->update_cycle[ch] = Host_GetCycles();
+}
+
+/**
+ * @brief 写入输入寄存器，LDAC寄存器中对应位为1的通道同时更新。
+ */
+static void DAC8568_Model_WriteInput(DAC8568_ModelTypeDef *model, uint8_t ch, uint16_t data)
+{
+    model->input_reg[ch] = data;
+    if (model->ldac_mask & (1U << ch))
+    {
+        DAC8568_Model_Load(model, ch);
+    }
+}
+
+/**
+ * @brief 执行一个完整的32位帧 (参考数据手册第35页表4)。
+ * @param model DAC模型。
+ * @param frame 数值形式的帧 (DB31位于最高位)。
+ */
+void DAC8568_Model_Execute(DAC8568_ModelTypeDef *model, uint32_t frame)
+{
+    uint8_t cmd = (frame >> 24) & 0x0F;
+    uint8_t addr = (frame >> 20) & 0x0F;
+    uint16_t data = (uint16_t)(frame >> 4);
+    uint8_t first = (addr == BROADCAST) ? 0 : addr;
+    uint8_t last = (addr == BROADCAST) ? 7 : addr;
+
+    model->frames++;
+    model->last_frame = frame;
+
+    switch (cmd)
+    {
+    case CMD_WRITE_INPUT_REG:
+    case CMD_WRITE_INPUT_UPDATE_ALL:
+    case CMD_WRITE_INPUT_UPDATE_ONE:
+    case CMD_UPDATE_DAC_REG:
+        if (addr > CHANNEL_H && addr != BROADCAST)
+        {
+            break; // 无效地址
+        }
+        for (uint8_t ch = first; ch <= last; ch++)
+        {
+            if (cmd != CMD_UPDATE_DAC_REG)
+            {
+                DAC8568_Model_WriteInput(model, ch, data);
+            }
+            if (cmd == CMD_UPDATE_DAC_REG || cmd == CMD_WRITE_INPUT_UPDATE_ONE)
+            {
+                DAC8568_Model_Load(model, ch);
+            }
+        }
+        if (cmd == CMD_WRITE_INPUT_UPDATE_ALL)
+        {
+            for (uint8_t ch = 0; ch < 8; ch++)
+            {
+                DAC8568_Model_Load(model, ch); // 软件LDAC: 全部通道同时更新
+            }
+        }
+        break;
+
+    case CMD_POWER_DOWN: // DB9-DB8: PD1/PD0，DB7-DB0: 通道H~A选择
+        for (uint8_t ch = 0; ch < 8; ch++)
+        {
+            if (frame & (1U << ch))
+            {
+                model->power_mode[ch] = (frame >> 8) & 0x03;
+            }
+        }
+        break;
+
+    case CMD_CLEAR_CODE_REG: // DB1-DB0: CC1/CC0
+        model->clear_code = frame & 0x03;
+        break;
+
+    case CMD_LDAC_REG: // DB7-DB0: 通道H~A
+        model->ldac_mask = frame & 0xFF;
+        break;
+
+    case CMD_SOFTWARE_RESET:
+        model->resets++;
+        model->reset_cycle = Host_GetCycles();
+        DAC8568_Model_Reset(model);
+        break;
+
+    case CMD_INTERNAL_REF:
+        if (addr == 0)
+        {
+            model->ref_static = frame & 0x01; // 静态模式: DB0
+        }
+        else
+        {
+            model->ref_flex = data; // 灵活模式: 记录数据位供检查
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 硬件LDAC引脚脉冲: 所有通道从输入寄存器更新。
+ * @param model DAC模型。
+ */
+void DAC8568_Model_PulseLdac(DAC8568_ModelTypeDef *model)
+{
+    for (uint8_t ch = 0; ch < 8; ch++)
+    {
+        DAC8568_Model_Load(model, ch);
+    }
+}
+
+/**
+ * @brief CLR引脚拉低: 按清除代码寄存器设置所有输入与DAC寄存器。
+ * @param model DAC模型。
+ */
+void DAC8568_Model_Clear(DAC8568_ModelTypeDef *model)
+{
+    static const uint16_t codes[3] = {0x0000, 0x8000, 0xFFFF};
+    if (model->clear_code == CLEAR_CODE_NO_OPERATION)
+    {
+        return;
+    }
+    for (uint8_t ch = 0; ch < 8; ch++)
+    {
+        model->input_reg[ch] = codes[model->clear_code];
+        DAC8568_Model_Load(model, ch);
+    }
+}
@@ -0,0 +1,215 @@
+/*
+ * DAC8568 压缩波形编码器 (主机端)
+ * 作者: 雪豹
+ */
+#include "DAC8568_WaveEnc.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief 按给定模式闭环编码一条记录的残差。
+ * @param x 本块该通道的样本。
+ * @param n 样本数。
+ * @param mode 模式字节 (DAC8568_WAVE_MODE)。
+ * @param tolerance 允许的最大重建误差。
+ * @param out 残差输出 (线性外推时先写初始斜率)，可为NULL (只检查是否可行)。
+ * @param max_error 输出: 本记录的最大重建误差。
+ * @retval 1 满足误差限，0 不满足。
+ * @note 重建运算与 DAC8568_Wave.c 中的解码完全相同 (16位取模)。
+ */
+static int DAC8568_WaveEnc_Try(const uint16_t *x, uint16_t n, uint8_t mode, uint16_t tolerance,
+                               uint8_t *out, uint32_t *max_error)
+{
+    uint8_t width = mode & DAC8568_WAVE_WIDTH_MASK;
+    uint8_t linear = (mode & DAC8568_WAVE_PREDICT_LINEAR) != 0;
+    uint8_t shift = mode >> DAC8568_WAVE_SHIFT_POS;
+    int32_t rmax = (width == DAC8568_WAVE_WIDTH_NONE) ? 0 : (1 << ((2 << width) - 1)) - 1;
+    int32_t rmin = (width == DAC8568_WAVE_WIDTH_NONE) ? 0 : -rmax - 1;
+    uint16_t value = x[0];
+    int16_t slope = 0;
+    uint32_t worst = 0;
+
+    if (linear)
+    {
+        slope = (n > 1) ? (int16_t)(uint16_t)(x[1] - x[0]) : 0; // 第一个残差为0
+        if (out != NULL)
+        {
+            out[0] = (uint8_t)slope;
+            out[1] = (uint8_t)((uint16_t)slope >> 8);
+            out += DAC8568_WAVE_SLOPE_SIZE;
+        }
+    }
+
+    for (uint16_t k = 1; k < n; k++)
+    {
+        uint16_t pred = (uint16_t)(value + slope);
+        int32_t r;
+        if (width == DAC8568_WAVE_WIDTH_16)
+        {
+            r = (int16_t)(uint16_t)(x[k] - pred); // 无损: 取模差值
+        }
+        else
+        {
+            int32_t diff = (int32_t)x[k] - (int32_t)pred;
+            r = (diff + ((1 << shift) >> 1)) >> shift; // 四舍五入 (算术右移)
+            r = (r < rmin) ? rmin : (r > rmax) ? rmax : r;
+        }
+        uint16_t rec = (uint16_t)(pred + r * (1 << shift));
+        uint32_t err = (uint32_t)abs((int32_t)rec - (int32_t)x[k]);
+        if (err > tolerance)
+        {
+            return 0;
+        }
+        worst = (err > worst) ? err : worst;
+        if (linear)
+        {
+            slope = (int16_t)(uint16_t)(rec - value);
+        }
+        value = rec;
+
+        if (out != NULL)
+        {
+            switch (width)
+            {
+            case DAC8568_WAVE_WIDTH_4:
+                if ((k - 1U) & 1U)
+                {
+                    out[(k - 1U) / 2U] |= (uint8_t)((r & 0x0F) << 4);
+                }
+                else
+                {
+                    out[(k - 1U) / 2U] = (uint8_t)(r & 0x0F);
+                }
+                break;
+            case DAC8568_WAVE_WIDTH_8:
+                out[k - 1U] = (uint8_t)r;
+                break;
+            case DAC8568_WAVE_WIDTH_16:
+                out[2U * (k - 1U)] = (uint8_t)r;
+                out[2U * (k - 1U) + 1U] = (uint8_t)((uint32_t)r >> 8);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+    *max_error = worst;
+    return 1;
+}
+
+/**
+ * @brief 为一条记录选择最短的可行模式。
+ * @param x 本块该通道的样本。
+ * @param n 样本数。
+ * @param tolerance 允许的最大重建误差。
+ * @retval 模式字节。16位无损模式总是可行。
+ * @note 残差宽度从小到大尝试；同一宽度内前一个样本预测 (无斜率字段，短2字节) 优先，
+ *       量化移位从小到大。
+ */
+static uint8_t DAC8568_WaveEnc_Choose(const uint16_t *x, uint16_t n, uint16_t tolerance)
+{
+    for (uint8_t width = DAC8568_WAVE_WIDTH_NONE; width < DAC8568_WAVE_WIDTH_16; width++)
+    {
+        uint8_t max_shift = (width == DAC8568_WAVE_WIDTH_NONE) ? 0 : 15;
+        for (uint8_t linear = 0; linear < 2; linear++)
+        {
+            for (uint8_t shift = 0; shift <= max_shift; shift++)
+            {
+                uint8_t mode = DAC8568_WAVE_MODE(width, linear ? DAC8568_WAVE_PREDICT_LINEAR : 0, shift);
+                uint32_t error;
+                if (DAC8568_WaveEnc_Try(x, n, mode, tolerance, NULL, &error))
+                {
+                    return mode;
+                }
+            }
+        }
+    }
+    return DAC8568_WAVE_MODE(DAC8568_WAVE_WIDTH_16, 0, 0);
+}
+
+/**
+ * @brief 编码多通道波形。
+ * @param samples 每通道的16位样本数组，只使用 channel_mask 中的通道。
+ * @param channel_mask 包含的通道 (bit0 = 通道A)。
+ * @param count 每通道样本数。
+ * @param block_len 每块每通道样本数 (关键帧间隔)。
+ * @param tolerance 允许的最大重建误差 (16位LSB)，0为无损。
+ * @param out 输出: 编码结果，用 DAC8568_WaveEnc_Free 释放。
+ * @retval 0 成功，-1 参数无效或内存不足。
+ */
+int DAC8568_WaveEnc_Encode(const uint16_t *const samples[8], uint8_t channel_mask, uint32_t count,
+                           uint16_t block_len, uint16_t tolerance, DAC8568_WaveEnc_ResultTypeDef *out)
+{
+    memset(out, 0, sizeof(*out));
+    if (channel_mask == 0 || count == 0 || block_len == 0)
+    {
+        return -1;
+    }
+
+    uint32_t active = 0;
+    for (uint8_t ch = 0; ch < 8; ch++)
+    {
+        active += (channel_mask >> ch) & 1U;
+    }
+    out->blocks = (count + block_len - 1U) / block_len;
+    size_t worst = (size_t)out->blocks * active *
+                   (DAC8568_WAVE_RECORD_HEADER + DAC8568_WAVE_SLOPE_SIZE + 2U * ((size_t)block_len - 1U));
+    out->data = malloc(worst);
+    out->block_offset = malloc(out->blocks * sizeof(uint32_t));
+    if (out->data == NULL || out->block_offset == NULL)
+    {
+        DAC8568_WaveEnc_Free(out);
+        return -1;
+    }
+
+    size_t pos = 0;
+    for (uint32_t b = 0; b < out->blocks; b++)
+    {
+        uint32_t start = b * block_len;
+        uint16_t n = (uint16_t)((count - start < block_len) ? count - start : block_len);
+        out->block_offset[b] = (uint32_t)pos;
+        for (uint8_t ch = 0; ch < 8; ch++)
+        {
+            if (!(channel_mask & (1U << ch)))
+            {
+                continue;
+            }
+            const uint16_t *x = samples[ch] + start;
+            uint8_t mode = DAC8568_WaveEnc_Choose(x, n, tolerance);
+            uint8_t width = mode & DAC8568_WAVE_WIDTH_MASK;
+            uint32_t bits = (width == DAC8568_WAVE_WIDTH_NONE) ? 0U : (2U << width);
+            uint32_t slope = (mode & DAC8568_WAVE_PREDICT_LINEAR) ? DAC8568_WAVE_SLOPE_SIZE : 0U;
+            uint32_t error;
+
+            out->data[pos] = (uint8_t)x[0];
+            out->data[pos + 1] = (uint8_t)(x[0] >> 8);
+            out->data[pos + 2] = mode;
+            pos += DAC8568_WAVE_RECORD_HEADER;
+            DAC8568_WaveEnc_Try(x, n, mode, UINT16_MAX, &out->data[pos], &error);
+            pos += slope + ((uint32_t)(n - 1U) * bits + 7U) / 8U;
+
+            out->mode_count[width]++;
+            out->max_error = (error > out->max_error) ? error : out->max_error;
+        }
+    }
+
+    out->size = pos;
+    out->wave.data = out->data;
+    out->wave.block_offset = out->block_offset;
+    out->wave.samples = count;
+    out->wave.block_len = block_len;
+    out->wave.channel_mask = channel_mask;
+    return 0;
+}
+
+/**
+ * @brief 释放编码结果。
+ * @param out 编码结果。
+ */
+void DAC8568_WaveEnc_Free(DAC8568_WaveEnc_ResultTypeDef *out)
+{
+    free(out->data);
+    free(out->block_offset);
+    out->data = NULL;
+    out->block_offset = NULL;
+}
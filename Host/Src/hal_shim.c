@@ -0,0 +1,480 @@
+/*
+ * 主机端 HAL 替身实现
+ * 作者: 雪豹
+ */
+#include "host_sim.h"
+
+GPIO_TypeDef Host_GPIOA, Host_GPIOB, Host_GPIOC;
+SPI_TypeDef Host_SPI1, Host_SPI2;
+uint32_t SystemCoreClock = 72000000U;
+DWT_Type Host_DWT;
+CoreDebug_Type Host_CoreDebug;
+uint32_t Host_PRIMASK;
+
+static uint64_t host_cycles; // 虚拟CPU周期计数
+
+// 挂接在SPI总线与SYNC引脚上的DAC模型
+static struct
+{
+    DAC8568_ModelTypeDef *model;
+    SPI_TypeDef *spi;
+    GPIO_TypeDef *sync_port;
+    uint16_t sync_pin;
+    GPIO_TypeDef *ldac_port; // 硬件LDAC引脚，NULL表示未连接
+    uint16_t ldac_pin;
+} host_models[HOST_MAX_MODELS];
+static uint8_t host_model_count;
+
+// 模拟的DMA传输完成中断 (在最外层的 HAL_SPI_Transmit_DMA 中依次分发，避免回调递归)
+static SPI_HandleTypeDef *host_pending_cplt[HOST_MAX_MODELS];
+static uint8_t host_pending_count;
+static uint8_t host_in_irq;
+static void (*host_preempt)(void); // 等待插入的模拟中断
+
+// SPI外设模拟: 发送缓冲区 (DR) 与移位寄存器
+typedef struct
+{
+    uint64_t shift_end;          // 移位寄存器中的数据项移完的时刻
+    uint16_t shift_item;         // 移位寄存器中的数据项
+    uint8_t shifting;            // 移位寄存器非空 (BSY)
+    uint16_t tx_item;            // 发送缓冲区中的数据项
+    uint8_t tx_full;             // 发送缓冲区非空 (TXE为0)
+    Host_SpiStatsTypeDef stats; // 访问计数
+} Host_SpiStateTypeDef;
+static Host_SpiStateTypeDef host_spi[2]; // 下标0为SPI1，1为SPI2
+
+/**
+ * @brief 将DAC模型挂接到指定SPI总线与SYNC引脚。
+ * @param model DAC模型。
+ * @param spi SPI实例 (SPI1/SPI2)。
+ * @param sync_port SYNC引脚端口。
+ * @param sync_pin SYNC引脚号。
+ */
+void Host_AttachModel(DAC8568_ModelTypeDef *model, SPI_TypeDef *spi, GPIO_TypeDef *sync_port, uint16_t sync_pin)
+{
+    if (host_model_count < HOST_MAX_MODELS)
+    {
+        host_models[host_model_count].model = model;
+        host_models[host_model_count].spi = spi;
+        host_models[host_model_count].sync_port = sync_port;
+        host_models[host_model_count].sync_pin = sync_pin;
+        host_models[host_model_count].ldac_port = NULL;
+        host_models[host_model_count].ldac_pin = 0;
+        host_model_count++;
+    }
+}
+
+/**
+ * @brief 把已挂接模型的LDAC引脚连接到指定GPIO，引脚的下降沿更新全部DAC寄存器。
+ * @param model 已由 Host_AttachModel 挂接的DAC模型。
+ * @param ldac_port LDAC引脚端口。
+ * @param ldac_pin LDAC引脚号。
+ */
+void Host_AttachLdac(DAC8568_ModelTypeDef *model, GPIO_TypeDef *ldac_port, uint16_t ldac_pin)
+{
+    for (uint8_t i = 0; i < host_model_count; i++)
+    {
+        if (host_models[i].model == model)
+        {
+            host_models[i].ldac_port = ldac_port;
+            host_models[i].ldac_pin = ldac_pin;
+        }
+    }
+}
+
+/**
+ * @brief 解除所有DAC模型的挂接。
+ */
+void Host_DetachAll(void)
+{
+    host_model_count = 0;
+}
+
+/**
+ * @brief 获取虚拟CPU周期计数。
+ * @retval 自程序启动以来的虚拟周期数 (72MHz)。
+ */
+uint64_t Host_GetCycles(void)
+{
+    return host_cycles;
+}
+
+/**
+ * @brief 推进虚拟CPU周期计数。
+ * @param cycles 周期数。
+ */
+void Host_AddCycles(uint64_t cycles)
+{
+    host_cycles += cycles;
+    if (Host_DWT.CTRL & DWT_CTRL_CYCCNTENA_Msk)
+    {
+        Host_DWT.CYCCNT += (uint32_t)cycles; // 与硬件相同，32位回绕
+    }
+}
+
+/**
+ * @brief 驱动代码的执行时间: 以 -fsanitize-coverage=trace-pc 编译的驱动源文件每进入一个基本块调用一次。
+ * @note 替身本身不插桩，HAL调用的开销仍由 HOST_CYCLES_* 常数计入。
+ */
+void __sanitizer_cov_trace_pc(void)
+{
+    Host_AddCycles(HOST_CYCLES_BLOCK);
+}
+
+/**
+ * @brief 计算SPI每个位占用的CPU周期数。
+ * @param spi SPI实例。
+ * @retval 周期数。SPI1位于APB2 (72MHz)，SPI2位于APB1 (36MHz)，分频由CR1的BR位决定。
+ */
+static uint32_t Host_SpiBitCycles(const SPI_TypeDef *spi)
+{
+    uint32_t pclk = (spi == SPI1) ? HAL_RCC_GetPCLK2Freq() : HAL_RCC_GetPCLK1Freq();
+    uint32_t div = 2U << ((spi->CR1 & SPI_CR1_BR) >> SPI_CR1_BR_Pos);
+    return div * (SystemCoreClock / pclk);
+}
+
+/**
+ * @brief 计算SPI每个位占用的CPU周期数。
+ * @param hspi SPI句柄 (已由 HAL_SPI_Init 配置)。
+ * @retval 周期数。
+ */
+uint32_t Host_GetSpiBitCycles(const SPI_HandleTypeDef *hspi)
+{
+    return Host_SpiBitCycles(hspi->Instance);
+}
+
+/**
+ * @brief 获取SPI外设的访问计数。
+ * @param spi SPI实例 (SPI1/SPI2)。
+ * @param stats 输出: 自上次 Host_ResetSpiStats 起的DR写入、SR读取与DMA搬运次数。
+ */
+void Host_GetSpiStats(const SPI_TypeDef *spi, Host_SpiStatsTypeDef *stats)
+{
+    *stats = host_spi[spi == SPI2].stats;
+}
+
+/**
+ * @brief 清零两条SPI总线的访问计数。
+ */
+void Host_ResetSpiStats(void)
+{
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        host_spi[i].stats = (Host_SpiStatsTypeDef){0};
+    }
+}
+
+/**
+ * @brief 把一个数据项移入挂接在该总线上的模型。
+ * @param spi SPI实例。
+ * @param item 数据项。
+ * @param width 数据帧宽度 (8或16)。
+ */
+static void Host_SpiDeliver(const SPI_TypeDef *spi, uint32_t item, uint8_t width)
+{
+    for (uint8_t i = 0; i < host_model_count; i++)
+    {
+        if (host_models[i].spi == spi)
+        {
+            DAC8568_Model_Shift(host_models[i].model, item, width);
+        }
+    }
+}
+
+/**
+ * @brief 按虚拟时钟推进SPI外设: 移完的数据项移入模型，发送缓冲区的数据项随即装入移位寄存器，并更新SR。
+ * @param spi SPI实例。
+ * @note 数据项在最后一位移出时才送入模型，SYNC在BSY清零前拉高会像硬件一样丢失该帧。
+ */
+static void Host_SpiUpdate(SPI_TypeDef *spi)
+{
+    uint8_t width = (spi->CR1 & SPI_CR1_DFF) ? 16 : 8;
+    uint32_t item_cycles = width * Host_SpiBitCycles(spi);
+    Host_SpiStateTypeDef *state = &host_spi[spi == SPI2];
+
+    while (state->shifting && host_cycles >= state->shift_end)
+    {
+        Host_SpiDeliver(spi, state->shift_item, width);
+        state->shifting = 0;
+        if (state->tx_full)
+        {
+            state->shift_item = state->tx_item; // SCLK不间断: 上一项移完的同时装入下一项
+            state->shift_end += item_cycles;
+            state->shifting = 1;
+            state->tx_full = 0;
+        }
+    }
+    spi->SR = (state->tx_full ? 0U : SPI_SR_TXE) | (state->shifting ? SPI_SR_BSY : 0U);
+}
+
+/**
+ * @brief CPU读SR。
+ * @param spi SPI实例。
+ * @retval SR的值 (TXE/BSY)。
+ */
+static uint32_t Host_SpiReadSR(SPI_TypeDef *spi)
+{
+    Host_SpiUpdate(spi);
+    host_spi[spi == SPI2].stats.sr_reads++;
+    return spi->SR;
+}
+
+/**
+ * @brief CPU写DR: 移位寄存器空闲时立即开始移位，否则进入发送缓冲区。
+ * @param spi SPI实例 (SPE已置位)。
+ * @param value 数据项。
+ * @note 与硬件相同，TXE为0时写入会覆盖发送缓冲区中尚未移出的数据项。
+ */
+static void Host_SpiWriteDR(SPI_TypeDef *spi, uint32_t value)
+{
+    uint8_t width = (spi->CR1 & SPI_CR1_DFF) ? 16 : 8;
+    Host_SpiStateTypeDef *state = &host_spi[spi == SPI2];
+
+    Host_SpiUpdate(spi);
+    state->stats.dr_writes++;
+    spi->DR = value;
+    if (!state->shifting)
+    {
+        state->shift_item = (uint16_t)value;
+        state->shift_end = host_cycles + width * Host_SpiBitCycles(spi);
+        state->shifting = 1;
+    }
+    else
+    {
+        state->tx_item = (uint16_t)value;
+        state->tx_full = 1;
+    }
+    Host_SpiUpdate(spi);
+}
+
+/**
+ * @brief 安排一次模拟中断: 在下一次未屏蔽中断 (PRIMASK为0) 时的GPIO写操作之前运行 isr。
+ * @param isr 中断处理函数，NULL取消尚未运行的中断。
+ * @note 用于检查驱动在"判断总线空闲"与"占用总线"之间能否被其它设备的传输完成中断打断。
+ */
+void Host_SetPreempt(void (*isr)(void))
+{
+    host_preempt = isr;
+}
+
+/**
+ * @brief 按BSRR的语义改变GPIO输出，并把SYNC/LDAC引脚的边沿通知挂接的模型。
+ * @param GPIOx GPIO端口。
+ * @param bsrr 低16位置位、高16位复位 (同一引脚两者都有时置位优先)。
+ */
+static void Host_GpioWrite(GPIO_TypeDef *GPIOx, uint32_t bsrr)
+{
+    if (host_preempt != NULL && Host_PRIMASK == 0)
+    {
+        void (*isr)(void) = host_preempt;
+        host_preempt = NULL;
+        isr();
+    }
+    Host_SpiUpdate(SPI1); // SYNC边沿之前移完的数据项先送入模型
+    Host_SpiUpdate(SPI2);
+    uint32_t old = GPIOx->ODR;
+    GPIOx->ODR = (old & ~(bsrr >> 16)) | (bsrr & 0xFFFFU);
+
+    for (uint8_t i = 0; i < host_model_count; i++)
+    {
+        uint32_t sync = host_models[i].sync_pin;
+        uint32_t ldac = host_models[i].ldac_pin;
+        if (host_models[i].sync_port == GPIOx && ((old ^ GPIOx->ODR) & sync))
+        {
+            DAC8568_Model_SetSync(host_models[i].model, (GPIOx->ODR & sync) != 0);
+        }
+        if (host_models[i].ldac_port == GPIOx && (old & ldac) && (GPIOx->ODR & ldac) == 0)
+        {
+            DAC8568_Model_PulseLdac(host_models[i].model);
+        }
+    }
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    Host_GpioWrite(GPIOx, (PinState != GPIO_PIN_RESET) ? GPIO_Pin : (uint32_t)GPIO_Pin << 16);
+    Host_AddCycles(HOST_CYCLES_GPIO_WRITE);
+}
+
+/**
+ * @brief READ_REG 的替身: SPI的SR经过外设模拟 (TXE/BSY随虚拟时钟变化)，其它寄存器直接读取。
+ * @param reg 寄存器地址。
+ * @retval 寄存器的值。
+ */
+uint32_t Host_ReadReg(volatile uint32_t *reg)
+{
+    Host_AddCycles(HOST_CYCLES_REG_ACCESS);
+    if (reg == &SPI1->SR || reg == &SPI2->SR)
+    {
+        return Host_SpiReadSR(reg == &SPI1->SR ? SPI1 : SPI2);
+    }
+    return *reg;
+}
+
+/**
+ * @brief WRITE_REG 的替身: SPI的DR开始发送，GPIO的BSRR改变引脚并通知模型，其它寄存器直接写入。
+ * @param reg 寄存器地址。
+ * @param value 写入值。
+ */
+void Host_WriteReg(volatile uint32_t *reg, uint32_t value)
+{
+    Host_AddCycles(HOST_CYCLES_REG_ACCESS);
+    if (reg == &SPI1->DR || reg == &SPI2->DR)
+    {
+        Host_SpiWriteDR(reg == &SPI1->DR ? SPI1 : SPI2, value);
+    }
+    else if (reg == &GPIOA->BSRR || reg == &GPIOB->BSRR || reg == &GPIOC->BSRR)
+    {
+        Host_GpioWrite((GPIO_TypeDef *)((uintptr_t)reg - offsetof(GPIO_TypeDef, BSRR)), value);
+    }
+    else
+    {
+        *reg = value;
+    }
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    return (GPIOx->ODR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef *hspi)
+{
+    // 只设置替身用到的位: 主模式、数据帧宽度与波特率分频，SPE在首次传输时置位
+    hspi->Instance->CR1 = SPI_CR1_MSTR | hspi->Init.DataSize | hspi->Init.BaudRatePrescaler;
+    host_spi[hspi->Instance == SPI2].shifting = 0;
+    host_spi[hspi->Instance == SPI2].tx_full = 0;
+    hspi->Instance->SR = SPI_SR_TXE;
+    hspi->State = HAL_SPI_STATE_READY;
+    return HAL_OK;
+}
+
+/**
+ * @brief HAL轮询循环中的一次SR读取 (含标志与超时判断的开销)。
+ * @param spi SPI实例。
+ * @retval SR的值。
+ */
+static uint32_t Host_HalPollSR(SPI_TypeDef *spi)
+{
+    uint32_t sr = Host_SpiReadSR(spi);
+    Host_AddCycles(HOST_CYCLES_SPI_POLL);
+    return sr;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    (void)Timeout;
+    if (hspi->State != HAL_SPI_STATE_READY)
+    {
+        return HAL_BUSY;
+    }
+    if (pData == NULL || Size == 0)
+    {
+        return HAL_ERROR;
+    }
+
+    SPI_TypeDef *spi = hspi->Instance;
+    hspi->State = HAL_SPI_STATE_BUSY_TX;
+    Host_AddCycles(HOST_CYCLES_SPI_CALL);
+    spi->CR1 |= SPI_CR1_SPE;
+
+    // 与HAL相同: 逐个数据项轮询TXE后写DR，8位模式的数据项数是16位模式的两倍
+    for (uint16_t n = 0; n < Size; n++)
+    {
+        while ((Host_HalPollSR(spi) & SPI_SR_TXE) == 0)
+        {
+        }
+        Host_SpiWriteDR(spi, (spi->CR1 & SPI_CR1_DFF) ? ((const uint16_t *)pData)[n] : pData[n]);
+        Host_AddCycles(HOST_CYCLES_SPI_ITEM);
+    }
+    // SPI_EndRxTxTransaction: 等待最后一个数据项移出
+    while ((Host_HalPollSR(spi) & (SPI_SR_TXE | SPI_SR_BSY)) != SPI_SR_TXE)
+    {
+    }
+    hspi->State = HAL_SPI_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size)
+{
+    if (hspi->State != HAL_SPI_STATE_READY)
+    {
+        return HAL_BUSY;
+    }
+    if (pData == NULL || Size == 0 || hspi->hdmatx == NULL)
+    {
+        return HAL_ERROR;
+    }
+
+    // 数据立即进入模型；CPU被视为一直等到传输完成中断 (与 DAC8568_WaitForTransfer 的用法一致)
+    SPI_TypeDef *spi = hspi->Instance;
+    uint8_t width = (spi->CR1 & SPI_CR1_DFF) ? 16 : 8;
+    hspi->State = HAL_SPI_STATE_BUSY_TX;
+    spi->CR1 |= SPI_CR1_SPE;
+    for (uint16_t n = 0; n < Size; n++)
+    {
+        Host_SpiDeliver(spi, (width == 16) ? ((const uint16_t *)pData)[n] : pData[n], width);
+    }
+    host_spi[spi == SPI2].stats.dma_items += Size;
+    Host_AddCycles(HOST_CYCLES_DMA_START + (uint64_t)Size * width * Host_SpiBitCycles(spi));
+    host_pending_cplt[host_pending_count++] = hspi;
+
+    if (host_in_irq)
+    {
+        return HAL_OK; // 在回调中再次启动: 由外层循环分发下一次中断
+    }
+    host_in_irq = 1;
+    while (host_pending_count > 0)
+    {
+        SPI_HandleTypeDef *done = host_pending_cplt[0];
+        for (uint8_t i = 1; i < host_pending_count; i++)
+        {
+            host_pending_cplt[i - 1] = host_pending_cplt[i];
+        }
+        host_pending_count--;
+        Host_AddCycles(HOST_CYCLES_DMA_IRQ);
+        done->State = HAL_SPI_STATE_READY; // 与HAL相同: 先恢复READY再调用回调
+        HAL_SPI_TxCpltCallback(done);
+    }
+    host_in_irq = 0;
+    return HAL_OK;
+}
+
+__attribute__((weak)) void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    (void)hspi;
+}
+
+__attribute__((weak)) void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+    (void)hspi;
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+    if (Delay < HAL_MAX_DELAY)
+    {
+        Delay++; // 与HAL相同: 至少等待完整的Delay个tick
+    }
+    Host_AddCycles((uint64_t)Delay * (SystemCoreClock / 1000U));
+}
+
+uint32_t HAL_GetTick(void)
+{
+    return (uint32_t)(host_cycles / (SystemCoreClock / 1000U));
+}
+
+uint32_t HAL_RCC_GetHCLKFreq(void)
+{
+    return SystemCoreClock;
+}
+
+uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+    return SystemCoreClock / 2U; // APB1分频2 (36MHz)，与SystemClock_Config一致
+}
+
+uint32_t HAL_RCC_GetPCLK2Freq(void)
+{
+    return SystemCoreClock; // APB2不分频 (72MHz)
+}
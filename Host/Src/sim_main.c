@@ -0,0 +1,1242 @@
+/*
+ * DAC8568 驱动主机端仿真程序
+ * 作者: 雪豹
+ */
+/*
+ * 在Linux上编译 Core/Src/DAC8568.c，驱动挂接在HAL替身上的DAC8568行为模型，
+ * 逐个调用驱动API并核对模型寄存器状态，再把DDS引擎生成的流式帧送入模型核对波形，最后运行 DAC8568_Bench。
+ * 性能测试的周期数由 host_sim.h 中HAL开销常数、SPI移位时间与驱动代码的基本块计数组成 (估计值)，
+ * 用于比较发送方式与各入口的开销；实际数值需在目标板上用DWT运行同一测试得到。
+ *
+ * 两种配置同时运行 (与 spi.c/main.c 中的硬件连接相同):
+ *   hdac1: SPI1 16位数据帧 + DMA发送 (DMA1通道3)，SYNC = PA4
+ *   hdac2: SPI2 16位数据帧 + DMA发送 (DMA1通道5)，SYNC = PB12
+ * 随后把SPI2改为8位数据帧 + 阻塞发送 (目标板上没有的备用配置)，重新初始化hdac2，再运行一遍API与跟踪检查，
+ * 覆盖8位帧格式与阻塞发送路径。
+ *
+ * Host/Makefile 以 DAC8568_BACKEND_HAL 与 DAC8568_BACKEND_REG 各编译一个程序，阻塞发送路径分别经过两种后端。
+ * 参数 --bench 只运行阻塞发送的性能测试并输出制表符分隔的表格 (make bench)。
+ *
+ * 返回值: 0 全部检查通过，1 存在不一致。
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "main.h"
+#include "DAC8568.h"
+#include "DAC8568_Bench.h"
+#include "DAC8568_DDS.h"
+#include "DAC8568_Cal.h"
+#include "DAC8568_Ramp.h"
+#include "DAC8568_Traj.h"
+#include "DAC8568_Wave.h"
+#include "DAC8568_WaveEnc.h"
+#include "DAC8568_Stream.h"
+#include "host_sim.h"
+
+static SPI_HandleTypeDef hspi1, hspi2;
+static DMA_HandleTypeDef hdma_spi1_tx, hdma_spi2_tx;
+static DAC8568_HandleTypeDef hdac1, hdac2;
+static DAC8568_ModelTypeDef model1, model2;
+static uint32_t failures;
+
+#define CHECK(cond)                                                      \
+    do                                                                   \
+    {                                                                    \
+        if (!(cond))                                                     \
+        {                                                                \
+            printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);     \
+            failures++;                                                  \
+        }                                                                \
+    } while (0)
+
+void Error_Handler(void)
+{
+}
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    DAC8568_TxCpltCallback(hspi);
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+    DAC8568_ErrorCallback(hspi);
+}
+
+static uint32_t async_done;
+static HAL_StatusTypeDef async_status;
+static SPI_HandleTypeDef *sim_preempt_spi;
+
+/**
+ * @brief 模拟中断: 同一总线上另一设备的传输占用总线。
+ */
+static void Sim_ClaimBus(void)
+{
+    sim_preempt_spi->State = HAL_SPI_STATE_BUSY_TX;
+}
+
+/**
+ * @brief 异步传输完成回调: 记录结果。
+ */
+static void Sim_AsyncCallback(DAC8568_HandleTypeDef *hdac, HAL_StatusTypeDef status)
+{
+    (void)hdac;
+    async_done++;
+    async_status = status;
+}
+
+/**
+ * @brief 按CubeMX生成的参数 (spi.c) 初始化两条SPI总线: 两者均为16位数据帧、DMA发送，SCLK均为18MHz。
+ */
+static void Sim_InitSpi(void)
+{
+    hspi1.Instance = SPI1;
+    hspi1.Init.DataSize = SPI_DATASIZE_16BIT;
+    hspi1.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_4;
+    hspi1.hdmatx = &hdma_spi1_tx;
+
+    hspi2.Instance = SPI2;
+    hspi2.Init.DataSize = SPI_DATASIZE_16BIT;
+    hspi2.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_2;
+    hspi2.hdmatx = &hdma_spi2_tx;
+    HAL_SPI_Init(&hspi1);
+    HAL_SPI_Init(&hspi2);
+
+    HAL_GPIO_WritePin(SYNC_GPIO_Port, SYNC_Pin, GPIO_PIN_SET);
+    HAL_GPIO_WritePin(SYNC2_GPIO_Port, SYNC2_Pin, GPIO_PIN_SET);
+}
+
+/**
+ * @brief 改变SPI总线的数据帧宽度与发送方式，并重新初始化总线上的设备与模型。
+ * @param hspi SPI句柄 (SCLK不变)。
+ * @param datasize SPI_DATASIZE_8BIT 或 SPI_DATASIZE_16BIT。
+ * @param hdma 发送DMA，NULL表示阻塞发送。
+ * @param hdac 总线上的设备句柄。
+ * @param model 与该设备相连的DAC模型。
+ */
+static void Sim_ConfigBus(SPI_HandleTypeDef *hspi, uint32_t datasize, DMA_HandleTypeDef *hdma,
+                          DAC8568_HandleTypeDef *hdac, DAC8568_ModelTypeDef *model)
+{
+    DAC8568_WaitForTransfer(hdac);
+    hspi->Init.DataSize = datasize;
+    hspi->hdmatx = hdma;
+    HAL_SPI_Init(hspi);
+    DAC8568_Model_Init(model, 0x0000);
+    DAC8568_Init(hdac, hspi, hdac->sync_port, hdac->sync_pin);
+    DAC8568_WaitForTransfer(hdac);
+}
+
+/**
+ * @brief 核对驱动的影子寄存器与模型的芯片状态是否一致。
+ * @param hdac 设备句柄。
+ * @param model DAC模型。
+ * @retval 1 一致，0 不一致。
+ */
+static uint8_t Sim_ShadowMatches(DAC8568_HandleTypeDef *hdac, const DAC8568_ModelTypeDef *model)
+{
+    const DAC8568_ShadowTypeDef *shadow = DAC8568_GetShadow(hdac);
+    for (uint8_t ch = 0; ch < 8; ch++)
+    {
+        if (shadow->input_reg[ch] != model->input_reg[ch] || shadow->dac_reg[ch] != model->dac_reg[ch] ||
+            shadow->power_mode[ch] != model->power_mode[ch])
+        {
+            return 0;
+        }
+    }
+    return shadow->ldac_mask == model->ldac_mask && shadow->clear_code == model->clear_code &&
+           shadow->ref_static == model->ref_static && shadow->ref_flex == model->ref_flex;
+}
+
+/**
+ * @brief 对一个设备依次调用全部驱动API并核对模型状态。
+ * @param name 配置名称。
+ * @param hdac 设备句柄。
+ * @param model 与该设备相连的DAC模型。
+ */
+static void Sim_CheckApi(const char *name, DAC8568_HandleTypeDef *hdac, DAC8568_ModelTypeDef *model)
+{
+    static const uint16_t ramp[8] = {0x1000, 0x2000, 0x3000, 0x4000, 0x5000, 0x6000, 0x7000, 0x8000};
+    static const uint16_t steps[8] = {0xF000, 0xE000, 0xD000, 0xC000, 0xB000, 0xA000, 0x9000, 0x0123};
+    uint16_t data[8];
+    uint32_t frames[64];
+    uint16_t samples[64];
+    uint32_t failures_before = failures;
+
+    printf("[%s]\n", name);
+
+    CHECK(model->resets == 1); // DAC8568_Init 发送软件复位
+    CHECK(model->aborted == 0);
+    CHECK(DAC8568_GetShadow(hdac)->valid && Sim_ShadowMatches(hdac, model));
+
+    DAC8568_Write(hdac, CHANNEL_C, 0x1234);
+    CHECK(model->input_reg[CHANNEL_C] == 0x1234);
+    CHECK(model->dac_reg[CHANNEL_C] == 0x0000);
+
+    DAC8568_Update(hdac, CHANNEL_C);
+    CHECK(model->dac_reg[CHANNEL_C] == 0x1234);
+
+    DAC8568_WriteAndUpdate(hdac, BROADCAST, 0x8000);
+    for (uint8_t ch = 0; ch < 8; ch++)
+    {
+        CHECK(model->dac_reg[ch] == 0x8000);
+    }
+
+    for (uint8_t ch = 0; ch < 8; ch++)
+    {
+        data[ch] = ramp[ch];
+    }
+    DAC8568_WriteAllChannels(hdac, data);
+    for (uint8_t ch = 0; ch < 8; ch++)
+    {
+        CHECK(model->input_reg[ch] == ramp[ch]);
+        CHECK(model->dac_reg[ch] == 0x8000);
+    }
+    DAC8568_UpdateAllChannels(hdac);
+    for (uint8_t ch = 0; ch < 8; ch++)
+    {
+        CHECK(model->dac_reg[ch] == ramp[ch]);
+    }
+
+    // 8通道原子更新: 最后一帧更新全部通道，所有通道的更新时刻相同
+    DAC8568_WriteAndUpdateAllChannels(hdac, steps);
+    for (uint8_t ch = 0; ch < 8; ch++)
+    {
+        CHECK(model->dac_reg[ch] == steps[ch]);
+        CHECK(model->update_cycle[ch] == model->update_cycle[CHANNEL_H]);
+    }
+
+    DAC8568_SetPowerMode(hdac, CHANNEL_E, POWER_DOWN_100K);
+    for (uint8_t ch = 0; ch < 8; ch++)
+    {
+        CHECK(model->power_mode[ch] == (ch == CHANNEL_E ? POWER_DOWN_100K : POWER_UP));
+    }
+    DAC8568_SetPowerMode(hdac, BROADCAST, POWER_DOWN_HIZ);
+    CHECK(model->power_mode[CHANNEL_A] == POWER_DOWN_HIZ && model->power_mode[CHANNEL_H] == POWER_DOWN_HIZ);
+    DAC8568_SetPowerMode(hdac, BROADCAST, POWER_UP);
+    CHECK(model->power_mode[CHANNEL_E] == POWER_UP);
+
+    DAC8568_EnableStaticInternalRef(hdac);
+    CHECK(model->ref_static == 1);
+    DAC8568_DisableStaticInternalRef(hdac);
+    CHECK(model->ref_static == 0);
+
+    DAC8568_EnableFlexMode(hdac);
+    CHECK(model->ref_flex == (1 << 13));
+    DAC8568_SetFlexModeRefAlwaysOn(hdac, 1);
+    CHECK(model->ref_flex == (1 << 15));
+    DAC8568_SetFlexModeRefAlwaysOff(hdac, 1);
+    CHECK(model->ref_flex == (1 << 14));
+    DAC8568_DisableFlexMode(hdac);
+    CHECK(model->ref_flex == 0);
+
+    DAC8568_SetClearCode(hdac, CLEAR_CODE_MID_SCALE);
+    CHECK(model->clear_code == CLEAR_CODE_MID_SCALE);
+    CHECK(Sim_ShadowMatches(hdac, model));
+
+    // 冗余命令被跳过: 相同设定值、相同电源模式、未变化的8通道连发
+    uint32_t sent = model->frames;
+    uint32_t skipped = hdac->frames_skipped;
+    DAC8568_WriteAndUpdate(hdac, CHANNEL_A, DAC8568_GetOutputCode(hdac, CHANNEL_A));
+    DAC8568_SetPowerMode(hdac, BROADCAST, POWER_UP);
+    DAC8568_SetClearCode(hdac, CLEAR_CODE_MID_SCALE);
+    DAC8568_WriteAndUpdateAllChannels(hdac, steps);
+    CHECK(model->frames == sent);
+    CHECK(hdac->frames_skipped - skipped == 11);
+    for (uint8_t ch = 0; ch < 8; ch++) // 只改一个通道: 发送B和最后的全部更新帧
+    {
+        data[ch] = (ch == CHANNEL_B) ? 0x0BBB : steps[ch];
+    }
+    DAC8568_WriteAndUpdateAllChannels(hdac, data);
+    CHECK(model->frames - sent == 2);
+    CHECK(model->dac_reg[CHANNEL_B] == 0x0BBB);
+    CHECK(Sim_ShadowMatches(hdac, model));
+
+    // CLR引脚在驱动之外改变芯片状态，影子寄存器失效后不再跳过
+    DAC8568_Model_Clear(model);
+    CHECK(model->dac_reg[CHANNEL_A] == 0x8000);
+    DAC8568_InvalidateShadow(hdac);
+    sent = model->frames;
+    DAC8568_SetClearCode(hdac, CLEAR_CODE_MID_SCALE);
+    CHECK(model->frames - sent == 1);
+
+    // 流式输出占用期间被丢弃的命令不改变影子寄存器，之后同样的命令照常发送
+    hdac->streaming = 1;
+    sent = model->frames;
+    DAC8568_SetClearCode(hdac, CLEAR_CODE_ZERO_SCALE);
+    CHECK(model->frames == sent && DAC8568_GetShadow(hdac)->clear_code == CLEAR_CODE_MID_SCALE);
+    hdac->streaming = 0;
+    DAC8568_SetClearCode(hdac, CLEAR_CODE_ZERO_SCALE);
+    CHECK(model->frames - sent == 1 && model->clear_code == CLEAR_CODE_ZERO_SCALE);
+    DAC8568_SetClearCode(hdac, CLEAR_CODE_MID_SCALE);
+
+    // LDAC寄存器: 通道A-D写入输入寄存器即更新，之后用原始数据清除
+    DAC8568_SetLdacMask(hdac, 0x0F);
+    CHECK(model->ldac_mask == 0x0F);
+    DAC8568_Write(hdac, CHANNEL_B, 0x4321);
+    DAC8568_Write(hdac, CHANNEL_F, 0x4321);
+    CHECK(model->dac_reg[CHANNEL_B] == 0x4321);
+    CHECK(model->dac_reg[CHANNEL_F] == 0x8000);
+    uint8_t raw[4] = {0x06, 0x00, 0x00, 0x00};
+    DAC8568_SendRawData(hdac, raw);
+    CHECK(model->ldac_mask == 0x00);
+
+    for (uint16_t i = 0; i < 64; i++)
+    {
+        samples[i] = (uint16_t)(i * 1000U);
+    }
+    uint32_t before = model->frames;
+    DAC8568_EncodeFrames(hdac, frames, CMD_WRITE_INPUT_UPDATE_ONE, CHANNEL_D, samples, 64);
+    DAC8568_SendFrames(hdac, frames, 64);
+    DAC8568_WaitForTransfer(hdac);
+    CHECK(model->frames - before == 64);
+    CHECK(model->dac_reg[CHANNEL_D] == samples[63]);
+    CHECK(DAC8568_IsBusy(hdac) == 0);
+
+    // 命令队列: 入队后立即发送，队列清空
+    before = model->frames;
+    for (uint16_t i = 0; i < 20; i++)
+    {
+        CHECK(DAC8568_Enqueue(hdac, DAC8568_FRAME(CMD_WRITE_INPUT_UPDATE_ONE, CHANNEL_E, 0x100 + i, 0)));
+    }
+    DAC8568_WaitForTransfer(hdac);
+    CHECK(model->frames - before == 20);
+    CHECK(model->dac_reg[CHANNEL_E] == 0x100 + 19);
+    CHECK(DAC8568_GetQueueCount(hdac) == 0);
+    if (hdac->hspi->hdmatx != NULL)
+    {
+        // 模拟一帧正在传输: 入队的帧只排队不发送，队列满后拒绝，传输完成回调把队列一次发完
+        hdac->busy = 1;
+        before = model->frames;
+        for (uint16_t i = 0; i < DAC8568_QUEUE_SIZE; i++)
+        {
+            CHECK(DAC8568_Enqueue(hdac, DAC8568_FRAME(CMD_WRITE_INPUT_UPDATE_ONE, CHANNEL_F, 0x200 + i, 0)));
+        }
+        CHECK(DAC8568_Enqueue(hdac, DAC8568_FRAME(CMD_WRITE_INPUT_UPDATE_ONE, CHANNEL_F, 0xFFFF, 0)) == 0);
+        CHECK(hdac->queue_overflows == 1);
+        CHECK(model->frames == before && DAC8568_GetQueueCount(hdac) == DAC8568_QUEUE_SIZE);
+        DAC8568_TxCpltCallback(hdac->hspi);
+        CHECK(model->frames - before == DAC8568_QUEUE_SIZE);
+        CHECK(model->dac_reg[CHANNEL_F] == 0x200 + DAC8568_QUEUE_SIZE - 1);
+        CHECK(DAC8568_GetQueueCount(hdac) == 0 && DAC8568_IsBusy(hdac) == 0);
+
+        // 判断总线空闲之后、拉低SYNC之前到来的中断 (同一总线上其它设备的队列占用总线) 被关中断推迟，
+        // 本设备不会在总线被占用时拉低SYNC
+        uint32_t aborted = model->aborted;
+        before = model->frames;
+        sim_preempt_spi = hdac->hspi;
+        Host_SetPreempt(Sim_ClaimBus);
+        CHECK(DAC8568_Enqueue(hdac, DAC8568_FRAME(CMD_WRITE_INPUT_UPDATE_ONE, CHANNEL_F, 0x300, 0)));
+        Host_SetPreempt(NULL);
+        hdac->hspi->State = HAL_SPI_STATE_READY;
+        CHECK(model->aborted == aborted && model->frames - before == 1 && model->dac_reg[CHANNEL_F] == 0x300);
+
+        // 总线已被占用: 不拉低SYNC，帧留在队列中，总线释放后随下一次入队依次发出
+        before = model->frames;
+        hdac->hspi->State = HAL_SPI_STATE_BUSY_TX;
+        CHECK(DAC8568_Enqueue(hdac, DAC8568_FRAME(CMD_WRITE_INPUT_UPDATE_ONE, CHANNEL_F, 0x301, 0)));
+        CHECK(model->frames == before && model->aborted == aborted && DAC8568_GetQueueCount(hdac) == 1);
+        hdac->hspi->State = HAL_SPI_STATE_READY;
+        CHECK(DAC8568_Enqueue(hdac, DAC8568_FRAME(CMD_WRITE_INPUT_UPDATE_ONE, CHANNEL_F, 0x302, 0)));
+        DAC8568_WaitForTransfer(hdac);
+        CHECK(model->frames - before == 2 && model->dac_reg[CHANNEL_F] == 0x302 && DAC8568_GetQueueCount(hdac) == 0);
+    }
+
+    // 异步接口: 立即返回，结束时回调；设备忙时返回HAL_BUSY且不发送
+    DAC8568_RegisterCallback(hdac, Sim_AsyncCallback);
+    async_done = 0;
+    before = model->frames;
+    CHECK(DAC8568_WriteAndUpdate_Async(hdac, CHANNEL_G, 0x7777) == HAL_OK);
+    DAC8568_WaitForTransfer(hdac);
+    CHECK(async_done == 1 && async_status == HAL_OK && DAC8568_GetLastStatus(hdac) == HAL_OK);
+    CHECK(model->dac_reg[CHANNEL_G] == 0x7777);
+    CHECK(DAC8568_Write_Async(hdac, CHANNEL_G, 0x1111) == HAL_OK);
+    CHECK(async_done == 2 && model->input_reg[CHANNEL_G] == 0x1111);
+    CHECK(DAC8568_WriteAndUpdateAllChannels_Async(hdac, ramp) == HAL_OK);
+    CHECK(async_done == 3 && model->dac_reg[CHANNEL_H] == ramp[7] && model->dac_reg[CHANNEL_A] == ramp[0]);
+    CHECK(DAC8568_SendFrames_Async(hdac, frames, 64) == HAL_OK);
+    DAC8568_WaitForTransfer(hdac);
+    CHECK(async_done == 4 && model->dac_reg[CHANNEL_D] == samples[63]);
+    CHECK(model->frames - before == 1 + 1 + 8 + 64);
+    hdac->busy = 1; // 模拟上一帧仍在传输
+    CHECK(DAC8568_WriteAndUpdate_Async(hdac, CHANNEL_G, 0x2222) == HAL_BUSY);
+    if (hdac->hspi->hdmatx != NULL)
+    {
+        hdac->tx_async = 1; // 模拟异步传输中出现SPI错误
+        DAC8568_ErrorCallback(hdac->hspi);
+        CHECK(async_done == 5 && async_status == HAL_ERROR && DAC8568_GetLastStatus(hdac) == HAL_ERROR);
+    }
+    hdac->busy = 0;
+    CHECK(model->dac_reg[CHANNEL_G] == ramp[6]); // 忙时的调用没有发送
+    DAC8568_RegisterCallback(hdac, NULL);
+
+    // 最小更新间隔: 第二次更新等到间隔满足才发送，异步调用返回HAL_BUSY
+    uint32_t interval = DAC8568_UsToCycles(10);
+    DAC8568_SetMinInterval(hdac, CHANNEL_A, 10);
+    DAC8568_WriteAndUpdate(hdac, CHANNEL_A, 0x1000);
+    uint64_t first = model->update_cycle[CHANNEL_A];
+    CHECK(DAC8568_WriteAndUpdate_Async(hdac, CHANNEL_A, 0x2000) == HAL_BUSY);
+    CHECK(DAC8568_WriteAndUpdate_Async(hdac, CHANNEL_B, 0x2000) == HAL_OK); // 其它通道不受限制
+    DAC8568_WaitForTransfer(hdac);
+    DAC8568_WriteAndUpdate(hdac, CHANNEL_A, 0x2000);
+    CHECK(model->dac_reg[CHANNEL_A] == 0x2000);
+    CHECK(model->update_cycle[CHANNEL_A] - first >= interval);
+    CHECK(model->update_cycle[CHANNEL_A] - first < interval + 2000); // 只等待需要的时间
+    DAC8568_SetMinInterval(hdac, BROADCAST, 0);
+
+    DAC8568_SoftwareReset(hdac);
+    CHECK(model->resets == 2);
+    CHECK(model->dac_reg[CHANNEL_D] == model->reset_code);
+    CHECK(model->clear_code == CLEAR_CODE_ZERO_SCALE);
+    CHECK(DAC8568_GetShadow(hdac)->valid && Sim_ShadowMatches(hdac, model));
+    uint64_t reset_done = Host_GetCycles();
+    CHECK(reset_done - model->reset_cycle < 2000); // 复位函数不再等待1ms
+    CHECK(DAC8568_Enqueue(hdac, DAC8568_FRAME(CMD_WRITE_INPUT_UPDATE_ONE, CHANNEL_D, 0x4444, 0)) == 0); // 入队不等待恢复
+    CHECK(DAC8568_GetQueueCount(hdac) == 0 && Host_GetCycles() - reset_done < 2000);
+    DAC8568_WriteAndUpdate(hdac, CHANNEL_D, 0x4444); // 复位后的第一帧等待恢复时间
+    CHECK(model->update_cycle[CHANNEL_D] - model->reset_cycle >= DAC8568_UsToCycles(DAC8568_RESET_RECOVERY_US));
+    DAC8568_WriteAndUpdate(hdac, CHANNEL_D, model->reset_code);
+
+    CHECK(model->aborted == 0);
+    printf("  %s, %lu frames\n", failures == failures_before ? "ok" : "FAILED", (unsigned long)model->frames);
+}
+
+/**
+ * @brief 检查DDS引擎: 波形特征点、流式帧的命令分组与相位连续性。
+ */
+static void Sim_CheckDds(void)
+{
+    DAC8568_DDS_HandleTypeDef dds;
+    DAC8568_ModelTypeDef model;
+    uint32_t frames[12];
+    uint16_t codes[8];
+    uint32_t failures_before = failures;
+
+    printf("[dds]\n");
+    DAC8568_DDS_Init(&dds);
+    CHECK(DAC8568_DDS_TuningWord(1000000, 100000) == 42949672U); // 1kHz @ 100kHz
+    CHECK(DAC8568_DDS_TuningWord(50000000, 100000) == 0x80000000U);
+
+    // 4个采样一个周期: 正弦 中/峰/中/谷，三角 谷/中/峰/中，锯齿 谷/中下/中/中上，方波 峰/峰/谷/谷
+    DAC8568_DDS_SetChannel(&dds, CHANNEL_A, DAC8568_DDS_SINE, 0x40000000U, 32767, 0x8000);
+    DAC8568_DDS_SetChannel(&dds, CHANNEL_C, DAC8568_DDS_TRIANGLE, 0x40000000U, 32767, 0x8000);
+    DAC8568_DDS_SetChannel(&dds, CHANNEL_E, DAC8568_DDS_SAW, 0x40000000U, 32767, 0x8000);
+    DAC8568_DDS_SetChannel(&dds, CHANNEL_G, DAC8568_DDS_SQUARE, 0x40000000U, 32767, 0x8000);
+    CHECK(dds.active == 4);
+
+    DAC8568_DDS_Step(&dds, codes);
+    CHECK(codes[CHANNEL_A] == 0x8000 && codes[CHANNEL_C] == 0x0001 && codes[CHANNEL_E] == 0x0001);
+    CHECK(codes[CHANNEL_G] == 0xFFFE && codes[CHANNEL_B] == 0x8000);
+    DAC8568_DDS_Step(&dds, codes);
+    CHECK(codes[CHANNEL_A] == 0xFFFE && codes[CHANNEL_C] == 0x8000 && codes[CHANNEL_E] == 0x4000);
+    DAC8568_DDS_Step(&dds, codes);
+    CHECK(codes[CHANNEL_A] == 0x8000 && codes[CHANNEL_C] == 0xFFFE && codes[CHANNEL_E] == 0x8000);
+    CHECK(codes[CHANNEL_G] == 0x0001);
+    DAC8568_DDS_Step(&dds, codes);
+    CHECK(codes[CHANNEL_A] == 0x0001 && codes[CHANNEL_C] == 0x7FFF && codes[CHANNEL_E] == 0xBFFF);
+
+    // 流式帧: 4个通道一组，每组最后一帧更新全部通道；分两次渲染时组内位置连续
+    DAC8568_Model_Init(&model, 0x0000);
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        DAC8568_DDS_SetPhase(&dds, i, 0);
+    }
+    DAC8568_DDS_Render(&dds, frames, 5);
+    DAC8568_DDS_Render(&dds, frames + 5, 7);
+    for (uint8_t i = 0; i < 12; i++)
+    {
+        uint32_t frame = DAC8568_FRAME_TO_HALFWORDS(frames[i]); // 流式格式半字交换，再交换一次还原
+        CHECK(((frame >> 24) & 0x0F) == ((i % 4 == 3) ? CMD_WRITE_INPUT_UPDATE_ALL : CMD_WRITE_INPUT_REG));
+        CHECK(((frame >> 20) & 0x0F) == (uint32_t)(i % 4) * 2U);
+        DAC8568_Model_Execute(&model, frame);
+        if (i == 7)
+        {
+            CHECK(model.dac_reg[CHANNEL_A] == 0xFFFE && model.dac_reg[CHANNEL_E] == 0x4000);
+        }
+    }
+    CHECK(model.dac_reg[CHANNEL_A] == 0x8000 && model.dac_reg[CHANNEL_C] == 0xFFFE);
+    CHECK(model.dac_reg[CHANNEL_E] == 0x8000 && model.dac_reg[CHANNEL_G] == 0x0001);
+
+    // 定时LDAC: 整组只写输入寄存器，输出等到LDAC脉冲才更新
+    DAC8568_DDS_SetLdacStrobe(&dds, 1);
+    DAC8568_DDS_Render(&dds, frames, 4);
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        uint32_t frame = DAC8568_FRAME_TO_HALFWORDS(frames[i]);
+        CHECK(((frame >> 24) & 0x0F) == CMD_WRITE_INPUT_REG);
+        DAC8568_Model_Execute(&model, frame);
+    }
+    CHECK(model.dac_reg[CHANNEL_A] == 0x8000 && model.dac_reg[CHANNEL_G] == 0x0001);
+    DAC8568_Model_PulseLdac(&model);
+    CHECK(model.dac_reg[CHANNEL_A] == 0x0001 && model.dac_reg[CHANNEL_E] == 0xBFFF);
+    DAC8568_DDS_SetLdacStrobe(&dds, 0);
+
+    // 正弦插值误差: 非整点相位与理想值 (32768+32767×sin60° = 61145) 相差不超过3个码
+    DAC8568_DDS_SetChannel(&dds, CHANNEL_A, DAC8568_DDS_SINE, 0, 32767, 0x8000);
+    DAC8568_DDS_SetPhase(&dds, CHANNEL_A, 0x2AAAAAABU); // 60度
+    int32_t err = (int32_t)DAC8568_DDS_Sample(&dds.ch[CHANNEL_A]) - 61145;
+    CHECK(err >= -3 && err <= 3);
+
+    // 满幅跳变的自定义表: 插值差值达到65535时不溢出，输出在两点之间单调下降
+    static const int16_t step[2] = {32767, -32768};
+    DAC8568_DDS_SetChannel(&dds, CHANNEL_B, DAC8568_DDS_TABLE, 0, 32767, 0x8000);
+    DAC8568_DDS_SetTable(&dds, CHANNEL_B, step, 1);
+    DAC8568_DDS_SetPhase(&dds, CHANNEL_B, 0x60000000U); // 3/4处，理想值 32768 - 0.5×65535×32767/32768 ≈ 16384
+    err = (int32_t)DAC8568_DDS_Sample(&dds.ch[CHANNEL_B]) - 16384;
+    CHECK(err >= -2 && err <= 2);
+    uint16_t prev = 0xFFFF;
+    for (uint32_t k = 0; k < 64; k++)
+    {
+        DAC8568_DDS_SetPhase(&dds, CHANNEL_B, k << 25); // 0 到 0x7E000000
+        uint16_t code = DAC8568_DDS_Sample(&dds.ch[CHANNEL_B]);
+        CHECK(code <= prev);
+        prev = code;
+    }
+    DAC8568_DDS_SetPhase(&dds, CHANNEL_B, 0x7FFFFFFFU);
+    CHECK(DAC8568_DDS_Sample(&dds.ch[CHANNEL_B]) <= 2);
+
+    // 表点数超出1~16时不使用该表，输出中心码值
+    DAC8568_DDS_SetTable(&dds, CHANNEL_B, step, 0);
+    CHECK(DAC8568_DDS_Sample(&dds.ch[CHANNEL_B]) == 0x8000);
+    DAC8568_DDS_SetTable(&dds, CHANNEL_B, step, 17);
+    CHECK(DAC8568_DDS_Sample(&dds.ch[CHANNEL_B]) == 0x8000 && dds.ch[CHANNEL_B].table == NULL);
+
+    printf("  %s\n", failures == failures_before ? "ok" : "FAILED");
+}
+
+/**
+ * @brief 检查定时LDAC的TIM4初值: 按STM32向上计数、ARR预装载与PWM模式1逐个计数模拟LDAC引脚，
+ *        第一组最后一帧锁存之前没有下降沿，之后每组一个脉冲。
+ */
+static void Sim_CheckLdacTimer(void)
+{
+    static const uint32_t cases[][3] = {
+        // group_ticks, delay, width (DAC8568_Stream_SetupLdacTimer 中 psc = 0 与 psc = 1 时的取值)
+        {8U * 100U, DAC8568_STREAM_LDAC_DELAY + 2U, DAC8568_STREAM_LDAC_WIDTH + 1U},
+        {4U * 720U, DAC8568_STREAM_LDAC_DELAY / 2U + 2U, DAC8568_STREAM_LDAC_WIDTH / 2U + 1U},
+        {0x10000U - DAC8568_STREAM_LDAC_HEADROOM, DAC8568_STREAM_LDAC_DELAY + 2U, DAC8568_STREAM_LDAC_WIDTH + 1U},
+    };
+    uint32_t failures_before = failures;
+
+    printf("[ldac timer]\n");
+    for (uint8_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        uint32_t group_ticks = cases[i][0], delay = cases[i][1], width = cases[i][2];
+        uint32_t cnt;
+        uint32_t arr = DAC8568_Stream_LdacFirstReload(group_ticks, delay, width, &cnt);
+        uint32_t arr_preload = group_ticks - 1U;
+        uint32_t edges[3];
+        uint8_t n = 0;
+        uint8_t low = (cnt < width);
+        CHECK(arr <= 0xFFFFU && !low); // 16位ARR，启动时LDAC为高电平
+        for (uint32_t t = 1; t <= 3U * group_ticks + delay && n < 3; t++)
+        {
+            if (cnt == arr)
+            {
+                cnt = 0;
+                arr = arr_preload; // 更新事件: 预装载寄存器生效
+            }
+            else
+            {
+                cnt++;
+            }
+            if (!low && cnt < width)
+            {
+                edges[n++] = t;
+            }
+            low = (cnt < width);
+        }
+        CHECK(n == 3);
+        CHECK(edges[0] > group_ticks - 1U); // 第一组最后一帧在 group_ticks - 1 锁存，此前没有脉冲
+        CHECK(edges[0] == group_ticks - 1U + delay);
+        CHECK(edges[1] - edges[0] == group_ticks && edges[2] - edges[1] == group_ticks);
+    }
+
+    printf("  %s\n", failures == failures_before ? "ok" : "FAILED");
+}
+
+/**
+ * @brief 检查S曲线轨迹: 端点精确、单调、对称、加速度与加加速度上限，以及流式帧。
+ */
+static void Sim_CheckTraj(void)
+{
+    enum { RATE = 100000, N = 1000 };
+    static DAC8568_Traj_HandleTypeDef traj;
+    static uint16_t path[N + 1];
+    DAC8568_ModelTypeDef model;
+    uint32_t frames[6];
+    uint16_t codes[8] = {0};
+    uint32_t failures_before = failures;
+
+    printf("[trajectory]\n");
+    DAC8568_Traj_Init(&traj, RATE);
+    CHECK(DAC8568_Traj_Plan(&traj, CHANNEL_A, 1000, N, 0, 0) == HAL_ERROR); // 未启用
+    DAC8568_Traj_SetChannel(&traj, CHANNEL_A, 1000);
+    DAC8568_Traj_SetChannel(&traj, CHANNEL_C, 50000);
+
+    // 0.01s内移动60000码值: 加速度在 4D/T² = 2.4e9 与 8D/T² = 4.8e9 码值/s² 之间
+    CHECK(DAC8568_Traj_Plan(&traj, CHANNEL_A, 61000, N, 2000000000U, 0) == HAL_ERROR); // 加速度上限过低
+    CHECK(DAC8568_Traj_Plan(&traj, CHANNEL_A, 61000, N, 3000000000U, 0) == HAL_OK);
+    CHECK(DAC8568_Traj_Plan(&traj, CHANNEL_A, 0, N, 0, 0) == HAL_BUSY);
+    CHECK(DAC8568_Traj_Plan(&traj, CHANNEL_C, 10000, N + 1, 0, 0) == HAL_OK); // 不限制: 加加速度最小，奇数时长
+    CHECK(DAC8568_Traj_GetMoving(&traj) == 0x05);
+
+    int64_t a_limit = (int64_t)((3000000000ULL << 30) / ((uint64_t)RATE * RATE)) << 16; // Q46/采样²
+    int64_t a_peak = 0;
+    for (uint32_t k = 0; k <= N; k++)
+    {
+        DAC8568_Traj_Step(&traj, codes);
+        path[k] = codes[CHANNEL_A];
+        int64_t a = traj.ch[CHANNEL_A].a;
+        a_peak = (a > a_peak) ? a : a_peak;
+        CHECK(k == 0 || path[k] >= path[k - 1]);
+    }
+    CHECK(path[0] == 1000 && path[N - 1] <= 61000 && path[N] == 61000);
+    for (uint32_t k = 2; k <= N / 2; k += 50)
+    {
+        CHECK(path[k] + path[N + 2 - k] == 2 * 1000 + 60000); // 前向差分延迟2个采样，关于 (N+2)/2 对称
+    }
+    CHECK(path[1] == 1000 && path[2] == 1000 && path[N / 2 + 1] == 31000);
+    CHECK(a_peak <= a_limit + a_limit / 100 && a_peak >= a_limit * 9 / 10);    // 用满加速度上限
+    CHECK(traj.ch[CHANNEL_A].jerk > 0 && traj.ch[CHANNEL_C].jerk < 0 && DAC8568_Traj_GetMoving(&traj) == 0);
+    DAC8568_Traj_Step(&traj, codes);
+    CHECK(codes[CHANNEL_C] == 10000 && DAC8568_Traj_GetMoving(&traj) == 0);
+    CHECK(codes[CHANNEL_A] == 61000 && codes[CHANNEL_B] == 0);
+
+    // 加加速度上限: 不限制加速度时 J = 32D/T³ (n1 = T/4)，0.01s内移动100码值为 3.2e9 码值/s³
+    CHECK(DAC8568_Traj_Plan(&traj, CHANNEL_A, 61100, N, 0, 3000000000U) == HAL_ERROR);
+    CHECK(DAC8568_Traj_Plan(&traj, CHANNEL_A, 61100, N, 0, 4000000000U) == HAL_OK);
+    CHECK(traj.ch[CHANNEL_A].len[0] == N / 4 && traj.ch[CHANNEL_A].len[1] == 0);
+
+    // 流式帧: A、C轮流，C静止时重复保持的位置
+    DAC8568_Model_Init(&model, 0x0000);
+    DAC8568_Traj_Render(&traj, frames, 6);
+    for (uint8_t i = 0; i < 6; i++)
+    {
+        uint32_t frame = DAC8568_FRAME_TO_HALFWORDS(frames[i]);
+        CHECK(((frame >> 24) & 0x0F) == ((i & 1U) ? CMD_WRITE_INPUT_UPDATE_ALL : CMD_WRITE_INPUT_REG));
+        DAC8568_Model_Execute(&model, frame);
+    }
+    CHECK(model.dac_reg[CHANNEL_A] == 61000 && model.dac_reg[CHANNEL_C] == 10000);
+
+    printf("  %s\n", failures == failures_before ? "ok" : "FAILED");
+}
+
+/**
+ * @brief 检查校准层: 定点修正、饱和、两点校准与8通道写入。
+ * @param hdac 设备句柄。
+ * @param model 与该设备相连的DAC模型。
+ */
+static void Sim_CheckCal(DAC8568_HandleTypeDef *hdac, DAC8568_ModelTypeDef *model)
+{
+    static const uint16_t targets[8] = {0, 1000, 10000, 20000, 30000, 40000, 50000, 65535};
+    DAC8568_CalTypeDef cal;
+    uint16_t out[8];
+    uint32_t failures_before = failures;
+
+    printf("[calibration]\n");
+    DAC8568_Cal_Init(&cal);
+    DAC8568_Cal_ApplyAll(&cal, targets, out);
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        CHECK(out[i] == targets[i]); // 初始为不修正
+    }
+
+    DAC8568_Cal_Set(&cal, CHANNEL_B, DAC8568_CAL_ONE / 2, 100 * DAC8568_CAL_ONE); // 0.5倍 + 100
+    CHECK(DAC8568_Cal_Apply(&cal.ch[CHANNEL_B], 1001) == 601); // 500.5 + 100 四舍五入
+    DAC8568_Cal_Set(&cal, CHANNEL_C, DAC8568_CAL_ONE + DAC8568_CAL_ONE / 10, -50 * DAC8568_CAL_ONE);
+    CHECK(DAC8568_Cal_Apply(&cal.ch[CHANNEL_C], 10) == 0);         // 下限饱和
+    CHECK(DAC8568_Cal_Apply(&cal.ch[CHANNEL_C], 65000) == 65535);  // 上限饱和
+    CHECK(DAC8568_Cal_Apply(&cal.ch[CHANNEL_C], 1000) == 1050);
+    DAC8568_Cal_Set(&cal, CHANNEL_E, INT32_MAX, 0); // 约32768倍: 乘积右移后超出int32，仍应饱和
+    CHECK(DAC8568_Cal_Apply(&cal.ch[CHANNEL_E], 65535) == 65535);
+    CHECK(DAC8568_Cal_Apply(&cal.ch[CHANNEL_E], 1) == 32768);
+
+    // 两点校准: 通道D实际输出 = 0.98 × 码值 + 120
+    DAC8568_Cal_TwoPoint(&cal, CHANNEL_D, 6000, 6000 * 98 / 100 + 120, 60000, 60000 * 98 / 100 + 120);
+    for (uint16_t target = 2000; target < 60000; target += 7919)
+    {
+        uint16_t code = DAC8568_Cal_Apply(&cal.ch[CHANNEL_D], target);
+        int32_t actual = (int32_t)code * 98 / 100 + 120;
+        CHECK(actual - target >= -1 && actual - target <= 1);
+    }
+
+    DAC8568_Cal_WriteAndUpdateAllChannels(hdac, &cal, targets);
+    DAC8568_WaitForTransfer(hdac);
+    DAC8568_Cal_ApplyAll(&cal, targets, out);
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        CHECK(model->dac_reg[i] == out[i]);
+    }
+    DAC8568_Cal_WriteAndUpdate(hdac, &cal, BROADCAST, 30000);
+    DAC8568_WaitForTransfer(hdac);
+    CHECK(model->dac_reg[CHANNEL_A] == 30000 && model->dac_reg[CHANNEL_B] == 15100);
+    DAC8568_Cal_Write(hdac, &cal, CHANNEL_B, 1001);
+    DAC8568_WaitForTransfer(hdac);
+    CHECK(model->input_reg[CHANNEL_B] == 601);
+
+    printf("  %s\n", failures == failures_before ? "ok" : "FAILED");
+}
+
+/**
+ * @brief 检查LDAC寄存器与硬件LDAC引脚。
+ * @param hdac 设备句柄。
+ * @param model 对应的芯片模型。
+ */
+static void Sim_CheckLdac(DAC8568_HandleTypeDef *hdac, DAC8568_ModelTypeDef *model)
+{
+    static const uint16_t data[8] = {100, 200, 300, 400, 500, 600, 700, 800};
+    uint16_t before[8];
+    uint32_t failures_before = failures;
+
+    printf("[ldac]\n");
+    DAC8568_WriteAndUpdate(hdac, BROADCAST, 0);
+    DAC8568_SetLdacMask(hdac, 0x05); // 通道A、C写入即更新
+    DAC8568_WaitForTransfer(hdac);
+    CHECK(model->ldac_mask == 0x05 && DAC8568_GetLdacMask(hdac) == 0x05);
+    DAC8568_Write(hdac, CHANNEL_A, 1111);
+    DAC8568_Write(hdac, CHANNEL_B, 2222);
+    DAC8568_WaitForTransfer(hdac);
+    CHECK(model->dac_reg[CHANNEL_A] == 1111 && model->dac_reg[CHANNEL_B] == 0);
+    CHECK(DAC8568_GetOutputCode(hdac, CHANNEL_A) == 1111 && DAC8568_GetOutputCode(hdac, CHANNEL_B) == 0);
+    DAC8568_SetLdacMask(hdac, 0xA0);
+    DAC8568_WaitForTransfer(hdac);
+    CHECK(model->ldac_mask == 0xA0);
+    uint32_t skipped = hdac->frames_skipped;
+    DAC8568_SetLdacMask(hdac, 0);
+    DAC8568_SetLdacMask(hdac, 0); // 重复命令被跳过
+    DAC8568_WaitForTransfer(hdac);
+    CHECK(model->ldac_mask == 0 && hdac->frames_skipped == skipped + 1);
+
+    // 硬件LDAC: 输入寄存器随时写入，脉冲时同时更新
+    DAC8568_PulseLdac(hdac); // 未连接引脚时不做任何操作
+    CHECK(model->dac_reg[CHANNEL_B] == 0);
+    Host_AttachLdac(model, LDAC_GPIO_Port, LDAC_Pin);
+    DAC8568_AttachLdacPin(hdac, LDAC_GPIO_Port, LDAC_Pin);
+    DAC8568_WriteAllChannels(hdac, (uint16_t *)data);
+    DAC8568_WaitForTransfer(hdac);
+    for (uint8_t ch = 0; ch < 8; ch++)
+    {
+        before[ch] = model->dac_reg[ch];
+    }
+    CHECK(before[CHANNEL_A] == 1111 && before[CHANNEL_H] == 0);
+    DAC8568_PulseLdac(hdac);
+    for (uint8_t ch = 0; ch < 8; ch++)
+    {
+        CHECK(model->dac_reg[ch] == data[ch] && DAC8568_GetOutputCode(hdac, ch) == data[ch]);
+    }
+    DAC8568_AttachLdacPin(hdac, NULL, 0);
+
+    printf("  %s\n", failures == failures_before ? "ok" : "FAILED");
+}
+
+/**
+ * @brief 检查斜坡发生器: 步进、同时到达、小数斜率与静止时不发帧。
+ * @param hdac 设备句柄。
+ * @param model 对应的芯片模型。
+ */
+static void Sim_CheckRamp(DAC8568_HandleTypeDef *hdac, DAC8568_ModelTypeDef *model)
+{
+    static DAC8568_RampTypeDef ramp;
+    uint32_t failures_before = failures;
+
+    printf("[ramp]\n");
+    DAC8568_WriteAndUpdate(hdac, BROADCAST, 1000);
+    DAC8568_WaitForTransfer(hdac);
+    DAC8568_Ramp_Init(&ramp, hdac);
+    CHECK(DAC8568_Ramp_GetMoving(&ramp) == 0 && DAC8568_Ramp_GetCode(&ramp, CHANNEL_H) == 1000);
+
+    // 节拍的连发不触发应用程序注册的异步回调
+    async_done = 0;
+    DAC8568_RegisterCallback(hdac, Sim_AsyncCallback);
+
+    // 静止时不发帧
+    uint32_t frames = model->frames;
+    CHECK(DAC8568_Ramp_Tick(&ramp) == HAL_OK && model->frames == frames);
+
+    // 每节拍4个码值，最后一步停在目标上
+    static const uint16_t steps[4] = {1004, 1008, 1010, 1010};
+    DAC8568_Ramp_SetTarget(&ramp, CHANNEL_A, 1010, DAC8568_RAMP_RATE(4));
+    CHECK(DAC8568_Ramp_GetMoving(&ramp) == 0x01);
+    for (uint8_t t = 0; t < 4; t++)
+    {
+        frames = model->frames;
+        DAC8568_Ramp_Tick(&ramp);
+        DAC8568_WaitForTransfer(hdac);
+        CHECK(model->dac_reg[CHANNEL_A] == steps[t] && model->frames == frames + (t < 3 ? 1U : 0U));
+    }
+    CHECK(DAC8568_Ramp_GetMoving(&ramp) == 0);
+
+    // 两个通道10个节拍同时到达，每节拍一次2帧的连发，最后一帧更新全部通道
+    DAC8568_Ramp_SetTargetIn(&ramp, CHANNEL_B, 2000, 10);
+    DAC8568_Ramp_SetTargetIn(&ramp, CHANNEL_C, 0, 10);
+    frames = model->frames;
+    for (uint8_t t = 0; t < 10; t++)
+    {
+        CHECK(DAC8568_Ramp_GetMoving(&ramp) == 0x06);
+        DAC8568_Ramp_Tick(&ramp);
+        DAC8568_WaitForTransfer(hdac);
+        CHECK(model->dac_reg[CHANNEL_B] == 1000 + 100 * (t + 1U) && model->dac_reg[CHANNEL_C] == 1000 - 100 * (t + 1U));
+        CHECK(((model->last_frame >> 24) & 0x0F) == CMD_WRITE_INPUT_UPDATE_ALL);
+    }
+    CHECK(model->frames == frames + 20 && DAC8568_Ramp_GetMoving(&ramp) == 0);
+
+    // 每节拍1/4码值: 只在码值变化的节拍发帧
+    DAC8568_Ramp_SetTarget(&ramp, CHANNEL_D, 1002, DAC8568_RAMP_RATE(1) / 4);
+    frames = model->frames;
+    for (uint8_t t = 0; t < 8; t++)
+    {
+        DAC8568_Ramp_Tick(&ramp);
+        DAC8568_WaitForTransfer(hdac);
+    }
+    CHECK(model->dac_reg[CHANNEL_D] == 1002 && model->frames == frames + 2);
+    CHECK(DAC8568_Ramp_GetMoving(&ramp) == 0 && ramp.late_ticks == 0);
+
+    // 运动中停止
+    DAC8568_Ramp_SetTarget(&ramp, BROADCAST, 5000, DAC8568_RAMP_RATE(100));
+    DAC8568_Ramp_Tick(&ramp);
+    DAC8568_Ramp_Stop(&ramp, BROADCAST);
+    DAC8568_WaitForTransfer(hdac);
+    CHECK(DAC8568_Ramp_GetMoving(&ramp) == 0 && model->dac_reg[CHANNEL_A] == 1110 && model->dac_reg[CHANNEL_C] == 100);
+    CHECK(async_done == 0);
+    DAC8568_RegisterCallback(hdac, NULL);
+
+    printf("  %s\n", failures == failures_before ? "ok" : "FAILED");
+}
+
+/**
+ * @brief 检查流式输出占用总线: 被占用总线上的设备丢弃普通命令，其它总线不受影响。
+ * @param hdac 被占用总线上的设备。
+ * @param model 对应的芯片模型。
+ * @param other 另一条总线上的设备。
+ * @param other_model 对应的芯片模型。
+ */
+static void Sim_CheckBusStreaming(DAC8568_HandleTypeDef *hdac, DAC8568_ModelTypeDef *model,
+                                  DAC8568_HandleTypeDef *other, DAC8568_ModelTypeDef *other_model)
+{
+    uint32_t failures_before = failures;
+
+    printf("[bus streaming]\n");
+    DAC8568_WaitForTransfer(hdac);
+    uint32_t frames = model->frames;
+    uint32_t other_frames = other_model->frames;
+    DAC8568_SetBusStreaming(hdac->hspi, 1);
+    CHECK(hdac->streaming && !other->streaming);
+    DAC8568_WriteAndUpdate(hdac, CHANNEL_A, 0x1357);
+    CHECK(DAC8568_Enqueue(hdac, DAC8568_FRAME(CMD_WRITE_INPUT_UPDATE_ONE, CHANNEL_B, 0x1357, 0)) == 0);
+    CHECK(DAC8568_WriteAndUpdate_Async(hdac, CHANNEL_C, 0x1357) == HAL_ERROR);
+    CHECK(model->frames == frames);
+    DAC8568_WriteAndUpdate(other, CHANNEL_A, 0x1357);
+    DAC8568_WaitForTransfer(other);
+    CHECK(other_model->frames == other_frames + 1 && other_model->dac_reg[CHANNEL_A] == 0x1357);
+
+    DAC8568_SetBusStreaming(hdac->hspi, 0);
+    DAC8568_WriteAndUpdate(hdac, CHANNEL_A, 0x1357);
+    DAC8568_WaitForTransfer(hdac);
+    CHECK(model->frames == frames + 1 && model->dac_reg[CHANNEL_A] == 0x1357);
+
+    printf("  %s\n", failures == failures_before ? "ok" : "FAILED");
+}
+
+/**
+ * @brief 检查SPI事务跟踪: 每帧一条记录、命令与地址解码、按命令统计与环形缓冲区覆盖。
+ * @param name 配置名称。
+ * @param hdac 设备句柄。
+ * @param model 对应的芯片模型。
+ */
+static void Sim_CheckTrace(const char *name, DAC8568_HandleTypeDef *hdac, DAC8568_ModelTypeDef *model)
+{
+#if DAC8568_TRACE
+    static DAC8568_TraceRecordTypeDef records[DAC8568_TRACE_SIZE];
+    static const uint16_t data[8] = {11, 22, 33, 44, 55, 66, 77, 88};
+    DAC8568_TraceStatsTypeDef stats[DAC8568_TRACE_CMDS];
+    uint32_t bus = 32U * DAC8568_Bench_GetBitCycles(hdac); // 一帧的移位时间，耗时的下限
+    uint32_t failures_before = failures;
+
+    printf("[trace: %s]\n", name);
+    DAC8568_WaitForTransfer(hdac);
+    DAC8568_Trace_Reset(hdac);
+    CHECK(DAC8568_Trace_Read(hdac, records, DAC8568_TRACE_SIZE) == 0);
+
+    // 单帧: 命令与地址由线上顺序帧解码
+    DAC8568_WriteAndUpdate(hdac, CHANNEL_C, 1234);
+    DAC8568_WaitForTransfer(hdac);
+    CHECK(DAC8568_Trace_Read(hdac, records, DAC8568_TRACE_SIZE) == 1);
+    CHECK(records[0].cmd == CMD_WRITE_INPUT_UPDATE_ONE && records[0].addr == CHANNEL_C && records[0].cycles >= bus);
+
+    // 8通道连发: 每帧一条记录，时间顺序递增
+    uint32_t frames = model->frames;
+    DAC8568_WriteAndUpdateAllChannels(hdac, data);
+    DAC8568_WaitForTransfer(hdac);
+    CHECK(model->frames == frames + 8);
+    CHECK(DAC8568_Trace_Read(hdac, records, DAC8568_TRACE_SIZE) == 9);
+    for (uint8_t k = 1; k < 9; k++)
+    {
+        CHECK(records[k].addr == k - 1U && records[k].start - records[k - 1].start >= records[k - 1].cycles);
+        CHECK(records[k].cmd == (k == 8 ? CMD_WRITE_INPUT_UPDATE_ALL : CMD_WRITE_INPUT_REG));
+    }
+    CHECK(DAC8568_Trace_Read(hdac, records, 2) == 2 && records[1].addr == CHANNEL_H); // 最近的两条
+
+    // 按命令统计
+    DAC8568_Trace_GetStats(hdac, stats);
+    CHECK(stats[CMD_WRITE_INPUT_REG].count == 7 && stats[CMD_WRITE_INPUT_UPDATE_ALL].count == 1);
+    CHECK(stats[CMD_WRITE_INPUT_UPDATE_ONE].count == 1 && stats[CMD_LDAC_REG].count == 0 && stats[CMD_LDAC_REG].min == 0);
+    const DAC8568_TraceStatsTypeDef *w = &stats[CMD_WRITE_INPUT_REG];
+    CHECK(w->min >= bus && w->min <= w->avg && w->avg <= w->max);
+
+    // 写满后覆盖最早的记录，统计不受影响
+    for (uint32_t i = 0; i < DAC8568_TRACE_SIZE; i++)
+    {
+        DAC8568_Write(hdac, CHANNEL_D, (uint16_t)(100 + i));
+    }
+    DAC8568_WaitForTransfer(hdac);
+    CHECK(hdac->trace.head == 9 + DAC8568_TRACE_SIZE);
+    CHECK(DAC8568_Trace_Read(hdac, records, DAC8568_TRACE_SIZE) == DAC8568_TRACE_SIZE);
+    CHECK(records[0].addr == CHANNEL_D && records[DAC8568_TRACE_SIZE - 1].addr == CHANNEL_D);
+    DAC8568_Trace_GetStats(hdac, stats);
+    CHECK(stats[CMD_WRITE_INPUT_REG].count == 7 + DAC8568_TRACE_SIZE);
+
+    printf("  %s\n", failures == failures_before ? "ok" : "FAILED");
+#else
+    (void)name;
+    (void)hdac;
+    (void)model;
+#endif
+}
+
+/**
+ * @brief 检查电压设定: 参考跟踪、倒数换算与饱和。
+ * @param hdac 设备句柄。
+ * @param model 对应的芯片模型。
+ */
+static void Sim_CheckVoltage(DAC8568_HandleTypeDef *hdac, DAC8568_ModelTypeDef *model)
+{
+    static const uint32_t mv[8] = {0, 1, 625, 1250, 2500, 3750, 4999, 6000};
+    uint32_t failures_before = failures;
+
+    printf("[voltage]\n");
+    DAC8568_DisableFlexMode(hdac);
+    DAC8568_DisableStaticInternalRef(hdac);
+    CHECK(DAC8568_GetFullScaleMicrovolts(hdac) == DAC8568_EXTERNAL_REF_UV * DAC8568_OUTPUT_GAIN);
+
+    DAC8568_SetExternalRef(hdac, 2048000); // 满量程4.096V，1LSB = 62.5μV
+    DAC8568_SetMillivolts(hdac, CHANNEL_A, 1000);
+    DAC8568_WaitForTransfer(hdac);
+    CHECK(model->dac_reg[CHANNEL_A] == 16000);
+    DAC8568_SetMicrovolts(hdac, CHANNEL_A, 1031); // 16.5 LSB 四舍五入
+    DAC8568_WaitForTransfer(hdac);
+    CHECK(model->dac_reg[CHANNEL_A] == 16);
+    DAC8568_SetMillivolts(hdac, CHANNEL_A, 5000);
+    DAC8568_WaitForTransfer(hdac);
+    CHECK(model->dac_reg[CHANNEL_A] == 65535); // 饱和
+    DAC8568_SetMillivolts(hdac, CHANNEL_A, 0);
+    DAC8568_SetMillivolts(hdac, CHANNEL_A, 4294968); // ×1000 超出32位，仍应饱和而不是回绕到小电压
+    DAC8568_WaitForTransfer(hdac);
+    CHECK(model->dac_reg[CHANNEL_A] == 65535);
+
+    DAC8568_EnableStaticInternalRef(hdac); // 切换到内部参考: 2.5V × 2
+    CHECK(DAC8568_GetFullScaleMicrovolts(hdac) == 5000000);
+    CHECK(DAC8568_MicrovoltsToCode(hdac, 2500000) == 32768);
+    DAC8568_SetMillivoltsAllChannels(hdac, mv);
+    DAC8568_WaitForTransfer(hdac);
+    for (uint8_t ch = 0; ch < 8; ch++)
+    {
+        uint64_t expect = ((uint64_t)mv[ch] * 65536U * 1000U + 2500000U) / 5000000U;
+        CHECK(model->dac_reg[ch] == (expect > 65535 ? 65535 : expect));
+    }
+    const uint32_t mv_big[8] = {4294968, UINT32_MAX, 4294967, 0, 0, 0, 0, 0};
+    DAC8568_SetMillivoltsAllChannels(hdac, mv_big);
+    DAC8568_WaitForTransfer(hdac);
+    CHECK(model->dac_reg[CHANNEL_A] == 65535 && model->dac_reg[CHANNEL_B] == 65535 && model->dac_reg[CHANNEL_C] == 65535);
+
+    DAC8568_SetFlexModeRefAlwaysOff(hdac, 1); // 灵活模式常关优先于静态模式
+    CHECK(DAC8568_MicrovoltsToCode(hdac, 1000000) == 16000);
+    DAC8568_SetFlexModeRefAlwaysOff(hdac, 0);
+    DAC8568_SetOutputGain(hdac, 1);
+    CHECK(DAC8568_MicrovoltsToCode(hdac, 1250000) == 32768);
+    DAC8568_SetOutputGain(hdac, DAC8568_OUTPUT_GAIN);
+    DAC8568_SetExternalRef(hdac, DAC8568_EXTERNAL_REF_UV);
+
+    printf("  %s\n", failures == failures_before ? "ok" : "FAILED");
+}
+
+/**
+ * @brief 检查压缩波形: 编码后由解码器逐组/逐帧还原，核对误差、跳转与循环。
+ */
+static void Sim_CheckWave(void)
+{
+    enum { COUNT = 1000, BLOCK = 64 };
+    static uint16_t sine[COUNT], tri[COUNT], flat[COUNT], noise[COUNT];
+    const uint16_t *samples[8] = {sine, NULL, tri, flat, noise};
+    DAC8568_DDS_HandleTypeDef dds;
+    DAC8568_WaveEnc_ResultTypeDef enc, lossy;
+    DAC8568_Wave_DecoderTypeDef dec;
+    uint16_t codes[8];
+    uint32_t frames[7];
+    uint32_t seed = 12345;
+    uint32_t failures_before = failures;
+
+    printf("[wave]\n");
+    DAC8568_DDS_Init(&dds);
+    DAC8568_DDS_SetChannel(&dds, CHANNEL_A, DAC8568_DDS_SINE, 0x01000000U, 30000, 0x8000);
+    DAC8568_DDS_SetChannel(&dds, CHANNEL_C, DAC8568_DDS_TRIANGLE, 0x00C00000U, 32767, 0x8000);
+    for (uint32_t n = 0; n < COUNT; n++)
+    {
+        DAC8568_DDS_Step(&dds, codes);
+        sine[n] = codes[CHANNEL_A];
+        tri[n] = codes[CHANNEL_C];
+        flat[n] = 0x1234;
+        seed = seed * 1103515245U + 12345U;
+        noise[n] = (uint16_t)(seed >> 16);
+    }
+
+    CHECK(DAC8568_WaveEnc_Encode(samples, 0x1D, COUNT, BLOCK, 0, &enc) == 0);
+    CHECK(enc.max_error == 0 && enc.blocks == 16);
+    CHECK(DAC8568_Wave_Init(&dec, &enc.wave, 0) == HAL_OK);
+    for (uint32_t n = 0; n < COUNT; n++)
+    {
+        DAC8568_Wave_Step(&dec, codes);
+        CHECK(codes[CHANNEL_A] == sine[n] && codes[CHANNEL_C] == tri[n]);
+        CHECK(codes[CHANNEL_D] == flat[n] && codes[CHANNEL_E] == noise[n]);
+        if (failures != failures_before)
+        {
+            printf("  at sample %lu\n", (unsigned long)n);
+            break;
+        }
+    }
+    CHECK(DAC8568_Wave_IsDone(&dec));
+    DAC8568_Wave_Step(&dec, codes); // 播放完毕后保持最后的样本
+    CHECK(codes[CHANNEL_A] == sine[COUNT - 1] && codes[CHANNEL_E] == noise[COUNT - 1]);
+
+    // 流式帧: 4个通道轮流，每组最后一帧同时更新；跳转后从中间开始，循环播放跨过结尾
+    CHECK(DAC8568_Wave_Init(&dec, &enc.wave, 1) == HAL_OK);
+    CHECK(DAC8568_Wave_Seek(&dec, COUNT - 1) == HAL_OK);
+    uint32_t n = COUNT - 1, slot = 0;
+    for (uint8_t pass = 0; pass < 3; pass++)
+    {
+        DAC8568_Wave_Render(&dec, frames, 7); // 不是4的整数倍
+        for (uint8_t i = 0; i < 7; i++)
+        {
+            static const uint8_t order[4] = {CHANNEL_A, CHANNEL_C, CHANNEL_D, CHANNEL_E};
+            uint32_t frame = (frames[i] << 16) | (frames[i] >> 16);
+            uint16_t data = (uint16_t)(frame >> 4);
+            CHECK(((frame >> 20) & 0x0F) == order[slot]);
+            CHECK(((frame >> 24) & 0x0F) == (slot == 3 ? CMD_WRITE_INPUT_UPDATE_ALL : CMD_WRITE_INPUT_REG));
+            CHECK(data == samples[order[slot]][n]);
+            if (++slot == 4)
+            {
+                slot = 0;
+                n = (n + 1) % COUNT;
+            }
+        }
+    }
+    CHECK(DAC8568_Wave_Seek(&dec, 777) == HAL_OK);
+    DAC8568_Wave_Step(&dec, codes);
+    CHECK(codes[CHANNEL_A] == sine[777] && codes[CHANNEL_E] == noise[777]);
+    CHECK(DAC8568_Wave_Seek(&dec, COUNT) == HAL_ERROR);
+
+    // 有损: 误差限4 LSB
+    CHECK(DAC8568_WaveEnc_Encode(samples, 0x1D, COUNT, BLOCK, 4, &lossy) == 0);
+    CHECK(lossy.max_error <= 4 && lossy.size < enc.size);
+    CHECK(DAC8568_Wave_Init(&dec, &lossy.wave, 0) == HAL_OK);
+    for (uint32_t k = 0; k < COUNT; k++)
+    {
+        DAC8568_Wave_Step(&dec, codes);
+        CHECK(abs((int32_t)codes[CHANNEL_A] - sine[k]) <= 4 && abs((int32_t)codes[CHANNEL_C] - tri[k]) <= 4);
+        CHECK(codes[CHANNEL_E] == noise[k]);
+    }
+    printf("  raw %u bytes, lossless %lu bytes (%.2fx), 4 LSB %lu bytes (%.2fx)\n", 4U * COUNT * 2U,
+           (unsigned long)enc.size, 8000.0 / (double)enc.size, (unsigned long)lossy.size, 8000.0 / (double)lossy.size);
+    DAC8568_WaveEnc_Free(&enc);
+    DAC8568_WaveEnc_Free(&lossy);
+
+    printf("  %s\n", failures == failures_before ? "ok" : "FAILED");
+}
+
+/**
+ * @brief 运行性能测试并输出结果 (DWT->CYCCNT由虚拟时钟驱动，结果为估计值)。
+ * @param name 配置名称。
+ * @param hdac 设备句柄。
+ * @param results 输出: 测试结果 (DAC8568_BENCH_COUNT 项)。
+ * @param stats 输出: 测试期间该总线的DR写入、SR读取与DMA搬运次数。
+ * @retval 测试项数量。
+ */
+static uint8_t Sim_Bench(const char *name, DAC8568_HandleTypeDef *hdac, DAC8568_BenchResultTypeDef *results,
+                         Host_SpiStatsTypeDef *stats)
+{
+#if DAC8568_TRACE
+    DAC8568_Trace_Reset(hdac);
+#endif
+    Host_ResetSpiStats();
+    uint8_t count = DAC8568_Bench_Run(hdac, results);
+    Host_GetSpiStats(hdac->hspi->Instance, stats);
+    printf("[bench: %s, %lu cycles/bit]\n", name, (unsigned long)DAC8568_Bench_GetBitCycles(hdac));
+    DAC8568_Bench_Print(results, count);
+#if DAC8568_TRACE
+    printf("[trace: %s]\n", name);
+    DAC8568_Bench_PrintTrace(hdac);
+#endif
+    return count;
+}
+
+/**
+ * @brief 在同一条总线、同一SCLK下对比8位/16位数据帧与DMA/阻塞发送，每次只改变一个条件。
+ * @param hspi SPI句柄。
+ * @param hdma 该总线的发送DMA。
+ * @param hdac 总线上的设备句柄。
+ * @param model 与该设备相连的DAC模型。
+ * @note 结束后总线恢复为16位数据帧、DMA发送。
+ */
+static void Sim_BenchFraming(SPI_HandleTypeDef *hspi, DMA_HandleTypeDef *hdma, DAC8568_HandleTypeDef *hdac,
+                             DAC8568_ModelTypeDef *model)
+{
+    static const struct
+    {
+        const char *name;
+        uint32_t datasize;
+        uint8_t dma;
+    } configs[4] = {
+        {"SPI1 16-bit DMA", SPI_DATASIZE_16BIT, 1},
+        {"SPI1 8-bit DMA", SPI_DATASIZE_8BIT, 1},
+        {"SPI1 16-bit blocking", SPI_DATASIZE_16BIT, 0},
+        {"SPI1 8-bit blocking", SPI_DATASIZE_8BIT, 0},
+    };
+    static DAC8568_BenchResultTypeDef results[4][DAC8568_BENCH_COUNT];
+    Host_SpiStatsTypeDef stats[4];
+    uint32_t frames[4] = {0};
+    uint8_t count = 0;
+
+    for (uint8_t c = 0; c < 4; c++)
+    {
+        Sim_ConfigBus(hspi, configs[c].datasize, configs[c].dma ? hdma : NULL, hdac, model);
+        count = Sim_Bench(configs[c].name, hdac, results[c], &stats[c]);
+        for (uint8_t n = 0; n < count; n++)
+        {
+            frames[c] += results[c][n].frames;
+        }
+        // 驱动代码计入周期: 64帧连发分摊了每次调用的开销，每帧周期数低于单帧写入
+        CHECK(results[c][10].cycles_per_frame < results[c][0].cycles_per_frame);
+        // 每帧的数据项: 16位模式2个，8位模式4个，阻塞发送由CPU写DR，DMA发送由DMA搬运。
+        // 最后一项的第一次调用设定值与前一项不同，比结果中的帧数多发送一帧
+        uint32_t items = (configs[c].datasize == SPI_DATASIZE_16BIT) ? 2U : 4U;
+        CHECK(stats[c].dr_writes == (configs[c].dma ? 0U : items * (frames[c] + 1U)));
+        CHECK(stats[c].dma_items == (configs[c].dma ? items * (frames[c] + 1U) : 0U));
+    }
+    Sim_ConfigBus(hspi, SPI_DATASIZE_16BIT, hdma, hdac, model);
+
+    // 汇总: 每帧CPU周期数 (含等待传输完成)，同一发送方式的两行只差数据帧宽度
+    printf("[bench summary: cycles/frame, %s backend]\n%-26s", (DAC8568_BACKEND == DAC8568_BACKEND_REG) ? "REG" : "HAL",
+           "entry");
+    for (uint8_t c = 0; c < 4; c++)
+    {
+        printf(" %21s", configs[c].name);
+    }
+    printf("\n");
+    for (uint8_t n = 0; n < count; n++)
+    {
+        printf("%-26s", results[0][n].name);
+        for (uint8_t c = 0; c < 4; c++)
+        {
+            printf(" %21lu", (unsigned long)results[c][n].cycles_per_frame);
+        }
+        printf("\n");
+    }
+
+    // 每帧的外设访问次数 (全部测试项的平均值)
+    static const char *const rows[3] = {"DR writes/frame", "SR reads/frame", "DMA items/frame"};
+    for (uint8_t r = 0; r < 3; r++)
+    {
+        printf("%-26s", rows[r]);
+        for (uint8_t c = 0; c < 4; c++)
+        {
+            uint32_t value = (r == 0) ? stats[c].dr_writes : (r == 1) ? stats[c].sr_reads : stats[c].dma_items;
+            printf(" %21.1f", (double)value / (double)frames[c]);
+        }
+        printf("\n");
+    }
+}
+
+/**
+ * @brief 只测量阻塞发送 (编译进来的 DAC8568_BACKEND)，输出制表符分隔的每帧周期数与外设访问次数，
+ *        供 make bench 把HAL与寄存器级后端并排比较。
+ * @param hspi SPI句柄。
+ * @param hdma 该总线的发送DMA (结束后恢复)。
+ * @param hdac 总线上的设备句柄。
+ * @param model 与该设备相连的DAC模型。
+ */
+static void Sim_BenchBackend(SPI_HandleTypeDef *hspi, DMA_HandleTypeDef *hdma, DAC8568_HandleTypeDef *hdac,
+                             DAC8568_ModelTypeDef *model)
+{
+    static const uint32_t sizes[2] = {SPI_DATASIZE_16BIT, SPI_DATASIZE_8BIT};
+    static DAC8568_BenchResultTypeDef results[2][DAC8568_BENCH_COUNT];
+    const char *backend = (DAC8568_BACKEND == DAC8568_BACKEND_REG) ? "REG" : "HAL";
+    Host_SpiStatsTypeDef stats[2];
+    uint32_t frames[2] = {0};
+    uint8_t count = 0;
+
+    for (uint8_t c = 0; c < 2; c++)
+    {
+        Sim_ConfigBus(hspi, sizes[c], NULL, hdac, model);
+        Host_ResetSpiStats();
+        count = DAC8568_Bench_Run(hdac, results[c]);
+        Host_GetSpiStats(hspi->Instance, &stats[c]);
+        for (uint8_t n = 0; n < count; n++)
+        {
+            frames[c] += results[c][n].frames;
+        }
+    }
+    Sim_ConfigBus(hspi, SPI_DATASIZE_16BIT, hdma, hdac, model);
+
+    printf("cycles/frame\t%s 16-bit\t%s 8-bit\n", backend, backend);
+    for (uint8_t n = 0; n < count; n++)
+    {
+        printf("%s\t%lu\t%lu\n", results[0][n].name, (unsigned long)results[0][n].cycles_per_frame,
+               (unsigned long)results[1][n].cycles_per_frame);
+    }
+    printf("DR writes/frame\t%.1f\t%.1f\n", (double)stats[0].dr_writes / frames[0],
+           (double)stats[1].dr_writes / frames[1]);
+    printf("SR reads/frame\t%.1f\t%.1f\n", (double)stats[0].sr_reads / frames[0],
+           (double)stats[1].sr_reads / frames[1]);
+}
+
+int main(int argc, char **argv)
+{
+    Sim_InitSpi();
+    DAC8568_Model_Init(&model1, 0x0000);
+    DAC8568_Model_Init(&model2, 0x0000);
+    Host_AttachModel(&model1, SPI1, SYNC_GPIO_Port, SYNC_Pin);
+    Host_AttachModel(&model2, SPI2, SYNC2_GPIO_Port, SYNC2_Pin);
+
+    DAC8568_Init(&hdac1, &hspi1, SYNC_GPIO_Port, SYNC_Pin);
+    DAC8568_Init(&hdac2, &hspi2, SYNC2_GPIO_Port, SYNC2_Pin);
+
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0)
+    {
+        Sim_BenchBackend(&hspi1, &hdma_spi1_tx, &hdac1, &model1); // make bench: 只输出性能测试表格
+        return 0;
+    }
+
+    Sim_CheckApi("SPI1 16-bit DMA", &hdac1, &model1);
+    Sim_CheckApi("SPI2 16-bit DMA", &hdac2, &model2);
+    Sim_CheckDds();
+    Sim_CheckLdacTimer();
+    Sim_CheckTraj();
+    Sim_CheckCal(&hdac1, &model1);
+    Sim_CheckVoltage(&hdac1, &model1);
+    Sim_CheckLdac(&hdac1, &model1);
+    Sim_CheckRamp(&hdac1, &model1);
+    Sim_CheckTrace("SPI1 16-bit DMA", &hdac1, &model1);
+    Sim_CheckTrace("SPI2 16-bit DMA", &hdac2, &model2);
+    Sim_CheckWave();
+    Sim_CheckBusStreaming(&hdac1, &model1, &hdac2, &model2);
+
+    // 备用配置: SPI2 8位数据帧 + 阻塞发送 (目标板上未使用)
+    Sim_ConfigBus(&hspi2, SPI_DATASIZE_8BIT, NULL, &hdac2, &model2);
+    Sim_CheckApi("SPI2 8-bit blocking (alternate)", &hdac2, &model2);
+    Sim_CheckTrace("SPI2 8-bit blocking (alternate)", &hdac2, &model2);
+
+    Sim_BenchFraming(&hspi1, &hdma_spi1_tx, &hdac1, &model1);
+
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
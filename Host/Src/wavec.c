@@ -0,0 +1,597 @@
+/*
+ * DAC8568 波形编译器 (主机端命令行工具)
+ * 作者: 雪豹
+ */
+/*
+ * 把每通道的样本文件编译为可直接链接进固件的Flash表，运行时不再需要编码:
+ *   -f frames  预编码流式帧 (DAC8568_STREAM_FRAME 格式，与 DAC8568_DDS_Render 的排列相同)，
+ *              直接交给 DAC8568_Stream_Start 循环播放；加 --ldac 时只写输入寄存器，用于定时LDAC
+ *   -f wave    压缩波形 (DAC8568_Wave.h 格式)，由 DAC8568_Wave_Render 逐块展开
+ *
+ * 输入:
+ *   --csv FILE      每行一组样本，每列一个通道 (逗号、分号或空白分隔)，列按 --channels 的顺序对应通道；
+ *                   空行与 '#' 开头的行忽略，第一行不是数字时视为表头
+ *   --raw CH=FILE   一个通道的原始样本 (16位小端)，CH为A~H，可重复
+ *   --bits N        输入样本的位数 (默认16)，小于16时左移到16位满量程
+ *
+ * 输出:
+ *   -o FILE.c  C源文件       -H FILE.h  头文件 (extern声明)       -b FILE.bin  二进制数据
+ *
+ * 最后输出压缩比，以及按链接脚本 (默认 STM32F103C8TX_FLASH.ld) 中的FLASH/RAM长度估算的占用。
+ */
+#include <ctype.h>
+#include <errno.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "DAC8568_Stream.h"
+#include "DAC8568_WaveEnc.h"
+
+// 目标板 (Cortex-M3，32位指针) 上的结构体大小，主机上的 sizeof 不适用
+#define WAVEC_TARGET_DESCRIPTOR_SIZE 16U // DAC8568_WaveTypeDef
+#define WAVEC_TARGET_DECODER_SIZE 124U   // DAC8568_Wave_DecoderTypeDef
+
+/**
+ * @brief 一个通道的输入样本。
+ */
+typedef struct
+{
+    uint16_t *samples;
+    uint32_t count;
+} Wavec_ChannelTypeDef;
+
+/**
+ * @brief 链接脚本中的存储器预算。
+ */
+typedef struct
+{
+    uint32_t flash;     // FLASH LENGTH
+    uint32_t ram;       // RAM LENGTH
+    uint32_t heap;      // _Min_Heap_Size
+    uint32_t stack;     // _Min_Stack_Size
+    int found;          // 1: 从链接脚本读取；0: 使用STM32F103C8的默认值
+} Wavec_BudgetTypeDef;
+
+static Wavec_ChannelTypeDef channels[8];
+
+/**
+ * @brief 输出错误信息并退出。
+ */
+static void Wavec_Fail(const char *msg, const char *arg)
+{
+    fprintf(stderr, "dac8568_wavec: %s%s%s\n", msg, arg ? ": " : "", arg ? arg : "");
+    exit(1);
+}
+
+/**
+ * @brief 向通道追加一个样本。
+ */
+static void Wavec_Append(Wavec_ChannelTypeDef *c, uint16_t value)
+{
+    if ((c->count & (c->count - 1U)) == 0) // 容量按2的幂增长
+    {
+        c->samples = realloc(c->samples, (c->count ? 2U * c->count : 1U) * sizeof(uint16_t));
+        if (c->samples == NULL)
+        {
+            Wavec_Fail("out of memory", NULL);
+        }
+    }
+    c->samples[c->count++] = value;
+}
+
+/**
+ * @brief 把输入样本换算为16位满量程。
+ * @param value 输入值。
+ * @param bits 输入样本位数。
+ * @param where 出错时显示的位置。
+ */
+static uint16_t Wavec_Scale(long value, unsigned bits, const char *where)
+{
+    if (value < 0 || value > (long)((1UL << bits) - 1U))
+    {
+        Wavec_Fail("sample out of range", where);
+    }
+    return (uint16_t)((unsigned long)value << (16U - bits));
+}
+
+/**
+ * @brief 读取CSV文件。
+ * @param path 文件名。
+ * @param order 各列对应的通道。
+ * @param columns 列数 (order 的长度)。
+ * @param bits 输入样本位数。
+ */
+static void Wavec_ReadCsv(const char *path, const uint8_t *order, unsigned columns, unsigned bits)
+{
+    FILE *f = fopen(path, "r");
+    char line[1024];
+    char where[64];
+    unsigned lineno = 0;
+    int first = 1;
+
+    if (f == NULL)
+    {
+        Wavec_Fail(strerror(errno), path);
+    }
+    while (fgets(line, sizeof(line), f) != NULL)
+    {
+        char *p = line;
+        lineno++;
+        while (isspace((unsigned char)*p))
+        {
+            p++;
+        }
+        if (*p == '\0' || *p == '#')
+        {
+            continue;
+        }
+        if (first && !isdigit((unsigned char)*p) && *p != '-' && *p != '+')
+        {
+            first = 0; // 表头
+            continue;
+        }
+        first = 0;
+
+        snprintf(where, sizeof(where), "%s:%u", path, lineno);
+        for (unsigned col = 0; col < columns; col++)
+        {
+            char *end;
+            errno = 0;
+            long value = strtol(p, &end, 0);
+            if (end == p || errno != 0)
+            {
+                Wavec_Fail("missing or invalid column", where);
+            }
+            Wavec_Append(&channels[order[col]], Wavec_Scale(value, bits, where));
+            p = end;
+            while (*p == ',' || *p == ';' || isspace((unsigned char)*p))
+            {
+                p++;
+            }
+        }
+    }
+    fclose(f);
+}
+
+/**
+ * @brief 读取一个通道的原始样本文件 (16位小端)。
+ * @param channel 通道。
+ * @param path 文件名。
+ * @param bits 输入样本位数。
+ */
+static void Wavec_ReadRaw(uint8_t channel, const char *path, unsigned bits)
+{
+    FILE *f = fopen(path, "rb");
+    uint8_t b[2];
+    if (f == NULL)
+    {
+        Wavec_Fail(strerror(errno), path);
+    }
+    while (fread(b, 1, 2, f) == 2)
+    {
+        Wavec_Append(&channels[channel], Wavec_Scale(b[0] | (b[1] << 8), bits, path));
+    }
+    fclose(f);
+}
+
+/**
+ * @brief 解析通道字母。
+ * @retval 通道号 (0~7)，无效时退出。
+ */
+static uint8_t Wavec_ParseChannel(char c)
+{
+    c = (char)toupper((unsigned char)c);
+    if (c < 'A' || c > 'H')
+    {
+        Wavec_Fail("channel must be A-H", NULL);
+    }
+    return (uint8_t)(c - 'A');
+}
+
+/**
+ * @brief 解析 "20K"、"0x400" 等长度写法。
+ */
+static uint32_t Wavec_ParseLength(const char *s)
+{
+    char *end;
+    unsigned long v = strtoul(s, &end, 0);
+    if (*end == 'K' || *end == 'k')
+    {
+        v *= 1024U;
+    }
+    else if (*end == 'M' || *end == 'm')
+    {
+        v *= 1024U * 1024U;
+    }
+    return (uint32_t)v;
+}
+
+/**
+ * @brief 从链接脚本读取FLASH/RAM长度与最小堆栈大小。
+ * @param path 链接脚本，NULL时依次尝试当前目录与上一级目录。
+ * @param budget 输出: 存储器预算，读不到时为STM32F103C8的默认值 (64K/20K)。
+ */
+static void Wavec_ReadBudget(const char *path, Wavec_BudgetTypeDef *budget)
+{
+    static const char *defaults[] = {"STM32F103C8TX_FLASH.ld", "../STM32F103C8TX_FLASH.ld"};
+    char line[256];
+    FILE *f = NULL;
+
+    budget->flash = 64U * 1024U;
+    budget->ram = 20U * 1024U;
+    budget->heap = 0x200;
+    budget->stack = 0x400;
+    budget->found = 0;
+
+    if (path != NULL)
+    {
+        f = fopen(path, "r");
+        if (f == NULL)
+        {
+            Wavec_Fail(strerror(errno), path);
+        }
+    }
+    for (unsigned i = 0; f == NULL && i < sizeof(defaults) / sizeof(defaults[0]); i++)
+    {
+        f = fopen(defaults[i], "r");
+    }
+    if (f == NULL)
+    {
+        return;
+    }
+
+    while (fgets(line, sizeof(line), f) != NULL)
+    {
+        char *len = strstr(line, "LENGTH =");
+        char *eq = strchr(line, '=');
+        if (len != NULL && strncmp(line + strspn(line, " \t"), "FLASH", 5) == 0)
+        {
+            budget->flash = Wavec_ParseLength(len + 8);
+            budget->found = 1;
+        }
+        else if (len != NULL && strncmp(line + strspn(line, " \t"), "RAM", 3) == 0)
+        {
+            budget->ram = Wavec_ParseLength(len + 8);
+        }
+        else if (eq != NULL && strncmp(line, "_Min_Heap_Size", 14) == 0)
+        {
+            budget->heap = Wavec_ParseLength(eq + 1);
+        }
+        else if (eq != NULL && strncmp(line, "_Min_Stack_Size", 15) == 0)
+        {
+            budget->stack = Wavec_ParseLength(eq + 1);
+        }
+    }
+    fclose(f);
+}
+
+/**
+ * @brief 把帧或压缩数据写为C源文件。
+ */
+static void Wavec_WriteSource(const char *path, const char *name, int frames_mode, const uint32_t *frames,
+                              uint32_t frame_count, const DAC8568_WaveEnc_ResultTypeDef *enc)
+{
+    FILE *f = fopen(path, "w");
+    if (f == NULL)
+    {
+        Wavec_Fail(strerror(errno), path);
+    }
+    fprintf(f, "/* 由 dac8568_wavec 生成，请勿手工修改 */\n");
+    if (frames_mode)
+    {
+        fprintf(f, "#include \"DAC8568_Stream.h\"\n\n");
+        fprintf(f, "const uint32_t %s_frames[%lu] = {", name, (unsigned long)frame_count);
+        for (uint32_t i = 0; i < frame_count; i++)
+        {
+            fprintf(f, "%s0x%08lXU,", (i % 8U) ? " " : "\n    ", (unsigned long)frames[i]);
+        }
+        fprintf(f, "\n};\n");
+    }
+    else
+    {
+        fprintf(f, "#include \"DAC8568_Wave.h\"\n\n");
+        fprintf(f, "static const uint8_t %s_data[%lu] = {", name, (unsigned long)enc->size);
+        for (size_t i = 0; i < enc->size; i++)
+        {
+            fprintf(f, "%s0x%02X,", (i % 16U) ? " " : "\n    ", enc->data[i]);
+        }
+        fprintf(f, "\n};\n\nstatic const uint32_t %s_block_offset[%lu] = {", name, (unsigned long)enc->blocks);
+        for (uint32_t i = 0; i < enc->blocks; i++)
+        {
+            fprintf(f, "%s%lu,", (i % 8U) ? " " : "\n    ", (unsigned long)enc->block_offset[i]);
+        }
+        fprintf(f, "\n};\n\n");
+        fprintf(f, "const DAC8568_WaveTypeDef %s = {\n", name);
+        fprintf(f, "    .data = %s_data,\n    .block_offset = %s_block_offset,\n", name, name);
+        fprintf(f, "    .samples = %luU,\n    .block_len = %uU,\n    .channel_mask = 0x%02XU,\n};\n",
+                (unsigned long)enc->wave.samples, enc->wave.block_len, enc->wave.channel_mask);
+    }
+    fclose(f);
+}
+
+/**
+ * @brief 写头文件。
+ */
+static void Wavec_WriteHeader(const char *path, const char *name, int frames_mode, uint32_t frame_count,
+                              uint32_t samples)
+{
+    FILE *f = fopen(path, "w");
+    if (f == NULL)
+    {
+        Wavec_Fail(strerror(errno), path);
+    }
+    fprintf(f, "/* 由 dac8568_wavec 生成，请勿手工修改 */\n#pragma once\n\n");
+    if (frames_mode)
+    {
+        fprintf(f, "#include \"DAC8568_Stream.h\"\n\n");
+        fprintf(f, "#define %s_FRAME_COUNT %luU\n", name, (unsigned long)frame_count);
+        fprintf(f, "extern const uint32_t %s_frames[%lu];\n", name, (unsigned long)frame_count);
+    }
+    else
+    {
+        fprintf(f, "#include \"DAC8568_Wave.h\"\n\n");
+        fprintf(f, "#define %s_SAMPLES %luU\n", name, (unsigned long)samples);
+        fprintf(f, "extern const DAC8568_WaveTypeDef %s;\n", name);
+    }
+    fclose(f);
+}
+
+/**
+ * @brief 写二进制数据: 帧为32位小端 (与目标板内存中的排列相同)，压缩波形为块数据。
+ */
+static void Wavec_WriteBinary(const char *path, int frames_mode, const uint32_t *frames, uint32_t frame_count,
+                              const DAC8568_WaveEnc_ResultTypeDef *enc)
+{
+    FILE *f = fopen(path, "wb");
+    if (f == NULL)
+    {
+        Wavec_Fail(strerror(errno), path);
+    }
+    if (frames_mode)
+    {
+        for (uint32_t i = 0; i < frame_count; i++)
+        {
+            uint8_t b[4] = {(uint8_t)frames[i], (uint8_t)(frames[i] >> 8), (uint8_t)(frames[i] >> 16),
+                            (uint8_t)(frames[i] >> 24)};
+            fwrite(b, 1, 4, f);
+        }
+    }
+    else
+    {
+        fwrite(enc->data, 1, enc->size, f);
+    }
+    fclose(f);
+}
+
+static void Wavec_Usage(void)
+{
+    fprintf(stderr,
+            "usage: dac8568_wavec [options] (--csv FILE | --raw CH=FILE ...)\n"
+            "  --csv FILE          samples per row, one column per channel\n"
+            "  --channels LIST     channels of the CSV columns, e.g. ACD (default ABCDEFGH)\n"
+            "  --raw CH=FILE       16-bit little-endian samples for channel CH (A-H), repeatable\n"
+            "  --bits N            input sample width, 1-16 (default 16)\n"
+            "  -f frames|wave      output pre-encoded stream frames or compressed waveform (default wave)\n"
+            "  -n NAME             C symbol name (default wave)\n"
+            "  --block N           samples per channel per block (default 64)\n"
+            "  --tolerance N       max reconstruction error in 16-bit LSB, 0 = lossless (default 0)\n"
+            "  --ldac              frames: input register writes only, for the timed LDAC strobe\n"
+            "  --buffer N          stream buffer frames for the RAM estimate (default 256)\n"
+            "  --ld FILE           linker script (default STM32F103C8TX_FLASH.ld in . or ..)\n"
+            "  --used-flash N      flash already used by the firmware, bytes\n"
+            "  --used-ram N        RAM already used by the firmware, bytes\n"
+            "  -o FILE.c  -H FILE.h  -b FILE.bin   outputs\n");
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    static const struct option options[] = {
+        {"csv", required_argument, NULL, 'c'},     {"channels", required_argument, NULL, 'C'},
+        {"raw", required_argument, NULL, 'r'},     {"bits", required_argument, NULL, 'B'},
+        {"block", required_argument, NULL, 'k'},   {"tolerance", required_argument, NULL, 't'},
+        {"buffer", required_argument, NULL, 'u'},  {"ld", required_argument, NULL, 'l'},
+        {"used-flash", required_argument, NULL, 'F'}, {"used-ram", required_argument, NULL, 'R'},
+        {"ldac", no_argument, NULL, 'L'},          {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}};
+    const char *csv = NULL, *columns = "ABCDEFGH", *ld = NULL;
+    const char *out_c = NULL, *out_h = NULL, *out_bin = NULL, *name = "wave";
+    const char *raw[8] = {NULL};
+    unsigned bits = 16, block = 64, tolerance = 0, buffer = 256;
+    uint32_t used_flash = 0, used_ram = 0;
+    int frames_mode = 0;
+    uint8_t update_cmd = CMD_WRITE_INPUT_UPDATE_ALL;
+    int opt;
+
+    while ((opt = getopt_long(argc, argv, "f:n:o:H:b:h", options, NULL)) != -1)
+    {
+        switch (opt)
+        {
+        case 'c': csv = optarg; break;
+        case 'C': columns = optarg; break;
+        case 'r':
+            if (strlen(optarg) < 3 || optarg[1] != '=')
+            {
+                Wavec_Fail("expected CH=FILE", optarg);
+            }
+            raw[Wavec_ParseChannel(optarg[0])] = optarg + 2;
+            break;
+        case 'B': bits = (unsigned)atoi(optarg); break;
+        case 'k': block = (unsigned)atoi(optarg); break;
+        case 't': tolerance = (unsigned)atoi(optarg); break;
+        case 'u': buffer = (unsigned)atoi(optarg); break;
+        case 'L': update_cmd = CMD_WRITE_INPUT_REG; break;
+        case 'l': ld = optarg; break;
+        case 'F': used_flash = Wavec_ParseLength(optarg); break;
+        case 'R': used_ram = Wavec_ParseLength(optarg); break;
+        case 'f':
+            if (strcmp(optarg, "frames") != 0 && strcmp(optarg, "wave") != 0)
+            {
+                Wavec_Fail("format must be frames or wave", optarg);
+            }
+            frames_mode = (strcmp(optarg, "frames") == 0);
+            break;
+        case 'n': name = optarg; break;
+        case 'o': out_c = optarg; break;
+        case 'H': out_h = optarg; break;
+        case 'b': out_bin = optarg; break;
+        default: Wavec_Usage();
+        }
+    }
+    if (bits < 1 || bits > 16 || block < 1 || block > 65535 || tolerance > 65535)
+    {
+        Wavec_Fail("invalid --bits, --block or --tolerance", NULL);
+    }
+
+    // 读取输入
+    if (csv != NULL)
+    {
+        uint8_t order[8];
+        unsigned n = (unsigned)strlen(columns);
+        if (n == 0 || n > 8)
+        {
+            Wavec_Fail("--channels must list 1-8 channels", columns);
+        }
+        for (unsigned i = 0; i < n; i++)
+        {
+            order[i] = Wavec_ParseChannel(columns[i]);
+        }
+        Wavec_ReadCsv(csv, order, n, bits);
+    }
+    for (uint8_t ch = 0; ch < 8; ch++)
+    {
+        if (raw[ch] != NULL)
+        {
+            if (channels[ch].count != 0)
+            {
+                Wavec_Fail("channel given twice", raw[ch]);
+            }
+            Wavec_ReadRaw(ch, raw[ch], bits);
+        }
+    }
+
+    uint8_t mask = 0, active = 0;
+    uint32_t samples = 0;
+    const uint16_t *data[8] = {NULL};
+    for (uint8_t ch = 0; ch < 8; ch++)
+    {
+        if (channels[ch].count == 0)
+        {
+            continue;
+        }
+        if (mask != 0 && channels[ch].count != samples)
+        {
+            Wavec_Fail("all channels must have the same number of samples", NULL);
+        }
+        samples = channels[ch].count;
+        data[ch] = channels[ch].samples;
+        mask |= (uint8_t)(1U << ch);
+        active++;
+    }
+    if (mask == 0)
+    {
+        Wavec_Usage();
+    }
+
+    // 编码
+    uint32_t *frames = NULL;
+    uint32_t frame_count = 0;
+    DAC8568_WaveEnc_ResultTypeDef enc;
+    memset(&enc, 0, sizeof(enc));
+    if (frames_mode)
+    {
+        frame_count = samples * active;
+        frames = malloc(frame_count * sizeof(uint32_t));
+        if (frames == NULL)
+        {
+            Wavec_Fail("out of memory", NULL);
+        }
+        for (uint32_t n = 0, i = 0; n < samples; n++)
+        {
+            uint8_t slot = 0;
+            for (uint8_t ch = 0; ch < 8; ch++)
+            {
+                if (mask & (1U << ch))
+                {
+                    uint8_t cmd = (++slot == active) ? update_cmd : CMD_WRITE_INPUT_REG;
+                    frames[i++] = DAC8568_STREAM_FRAME(cmd, ch, data[ch][n], 0);
+                }
+            }
+        }
+    }
+    else if (DAC8568_WaveEnc_Encode(data, mask, samples, (uint16_t)block, (uint16_t)tolerance, &enc) != 0)
+    {
+        Wavec_Fail("encoding failed", NULL);
+    }
+
+    if (out_c != NULL)
+    {
+        Wavec_WriteSource(out_c, name, frames_mode, frames, frame_count, &enc);
+    }
+    if (out_h != NULL)
+    {
+        Wavec_WriteHeader(out_h, name, frames_mode, frame_count, samples);
+    }
+    if (out_bin != NULL)
+    {
+        Wavec_WriteBinary(out_bin, frames_mode, frames, frame_count, &enc);
+    }
+
+    // 报告
+    Wavec_BudgetTypeDef budget;
+    Wavec_ReadBudget(ld, &budget);
+    uint32_t raw_bytes = samples * active * 2U;
+    uint32_t flash_bytes, ram_bytes;
+    printf("channels: ");
+    for (uint8_t ch = 0; ch < 8; ch++)
+    {
+        if (mask & (1U << ch))
+        {
+            printf("%c", 'A' + ch);
+        }
+    }
+    printf(", %lu samples/channel, raw 16-bit %lu B\n", (unsigned long)samples, (unsigned long)raw_bytes);
+    if (frames_mode)
+    {
+        flash_bytes = frame_count * 4U;
+        ram_bytes = 0; // DMA直接从Flash读取
+        printf("frames: %lu (%lu B, %.2fx raw)\n", (unsigned long)frame_count, (unsigned long)flash_bytes,
+               (double)flash_bytes / raw_bytes);
+        if (frame_count > 0x7FFF)
+        {
+            printf("warning: DAC8568_Stream_Start accepts at most 32767 frames\n");
+        }
+    }
+    else
+    {
+        flash_bytes = (uint32_t)enc.size + enc.blocks * 4U + WAVEC_TARGET_DESCRIPTOR_SIZE;
+        ram_bytes = WAVEC_TARGET_DECODER_SIZE + buffer * 4U;
+        printf("wave: %lu B data + %lu B block offsets, compression %.2fx, max error %lu LSB\n",
+               (unsigned long)enc.size, (unsigned long)enc.blocks * 4U, (double)raw_bytes / flash_bytes,
+               (unsigned long)enc.max_error);
+        printf("records: %lu constant, %lu 4-bit, %lu 8-bit, %lu 16-bit\n", (unsigned long)enc.mode_count[0],
+               (unsigned long)enc.mode_count[1], (unsigned long)enc.mode_count[2], (unsigned long)enc.mode_count[3]);
+    }
+
+    uint32_t ram_avail = budget.ram - budget.heap - budget.stack;
+    printf("flash: %lu B + firmware %lu B = %.1f%% of %lu B%s\n", (unsigned long)flash_bytes,
+           (unsigned long)used_flash, 100.0 * (flash_bytes + used_flash) / budget.flash, (unsigned long)budget.flash,
+           budget.found ? "" : " (default, linker script not found)");
+    printf("RAM:   %lu B", (unsigned long)ram_bytes);
+    if (!frames_mode)
+    {
+        printf(" (decoder %u B + stream buffer %u frames)", WAVEC_TARGET_DECODER_SIZE, buffer);
+    }
+    printf(" + firmware %lu B = %.1f%% of %lu B (RAM - heap - stack)\n", (unsigned long)used_ram,
+           100.0 * (ram_bytes + used_ram) / ram_avail, (unsigned long)ram_avail);
+
+    int over = (flash_bytes + used_flash > budget.flash) || (ram_bytes + used_ram > ram_avail);
+    if (over)
+    {
+        printf("error: exceeds the memory budget\n");
+    }
+    DAC8568_WaveEnc_Free(&enc);
+    free(frames);
+    return over ? 1 : 0;
+}